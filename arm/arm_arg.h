@@ -47,6 +47,7 @@ enum arm_arg_mode : uint8_t
 
 // Special modes to support particular RELOCs
     , MODE_CALL             // emit `R_ARM_CALL` reloc
+    , MODE_LITERAL          // `=expr`: load from literal pool
 
 // Required enumerations
     , NUM_ARG_MODES
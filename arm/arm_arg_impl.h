@@ -90,6 +90,9 @@ void arm_arg_t::print(OS& os) const
         case MODE_IMMEDIATE:
             os << "#" << expr;
             break;
+        case MODE_LITERAL:
+            os << "=" << expr;
+            break;
 
         // parts of immed
         case MODE_IMMED_LOWER:
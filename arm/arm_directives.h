@@ -20,6 +20,7 @@ namespace kas::arm::opc
     struct arm_opc_fpu;
     struct arm_opc_code;
     struct arm_opc_t_func;
+    struct arm_opc_ltorg;
 }
 
 namespace kas::arm::parser
@@ -47,6 +48,8 @@ using arm_ops = meta::list<
 , meta::list<opc::arm_opc_fpu     , STR(fpu)>
 , meta::list<opc::arm_opc_code    , STR(code)>
 , meta::list<opc::arm_opc_t_func  , STR(thumb_func)>
+, meta::list<opc::arm_opc_ltorg   , STR(ltorg)>
+, meta::list<opc::arm_opc_ltorg   , STR(pool)>
 #if 0
 , meta::list<opc::arm_opc_, STR()>
 #endif
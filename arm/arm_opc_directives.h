@@ -4,6 +4,7 @@
 #include "arm_addr_mapping.h"
 #include "arm_opc_eabi.h"
 #include "target/tgt_directives_impl.h"
+#include "kas_core/opc_literal.h"
 #include "utility/ci_string.h"
 
 
@@ -124,6 +125,29 @@ struct arm_opc_t_func : tgt_dir_opcode
     
 };
     
+//
+// place literal pool (`ldr rX, =expr` values) at current location
+//
+struct arm_opc_ltorg : tgt_dir_opcode
+{
+    static inline core::opc::opc_literal_pool base_op;
+
+    OPC_INDEX();
+    const char *name() const override { return "LTORG"; }
+
+    void tgt_proc_args(data_t& data, parser::tgt_dir_args&& args) const override
+    {
+        if (auto err = validate_min_max(args, 0, 0))
+            return make_error(data, err);
+    }
+
+    // `insn_inserter` places pool for `opc_literal_pool` insn
+    core::opc::opcode const& op() const override
+    {
+        return base_op;
+    }
+};
+
 //
 // control parser interpretation of address modes, etc
 //
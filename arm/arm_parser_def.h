@@ -139,7 +139,7 @@ auto const arg_regset = rule<class _, arm_parsed_arg_t> {"regset"}
 //
 // Parse simple arguments into `expr/MODE` pair
 //
-// Direct, Immediate, Register-set
+// Direct, Immediate, Register-set, Literal
 //
 
 auto const simple_parsed_arg = rule<class _, arm_parsed_arg_t> {"arm_parsed_arg"}
@@ -158,6 +158,7 @@ auto const simple_parsed_arg = rule<class _, arm_parsed_arg_t> {"arm_parsed_arg"
                                         ))
           ))
         | ('{' > arg_regset)
+        | (lit('=') > expr() > attr(MODE_LITERAL))
         ;
 
 //
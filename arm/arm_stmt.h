@@ -88,6 +88,10 @@ struct arm_stmt_t : tgt_stmt<arm_stmt_t
     template <typename Context>
     void operator()(Context const& ctx);
 
+    // validate args: allocate literal pool entries for `ldr rX, =expr`
+    template <typename ARGS_T, typename TRACE>
+    kas_error_t validate_args(insn_t const&, ARGS_T&, bool& args_arg_const, TRACE * = {});
+
     // suffix codes for ldr/str: xlate code in `info` into pointer
     arm_sfx_t const& sfx();
 
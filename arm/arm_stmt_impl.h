@@ -7,6 +7,8 @@
 #include "arm_mcode.h"
 #include "arm_stmt_ual.h"
 
+#include "kas_core/opc_literal.h"
+
 namespace kas::arm::parser
 {
 
@@ -28,6 +30,30 @@ void arm_stmt_t::operator()(Context const& ctx)
     x3::_val(ctx) = &stmt;
 }
 
+// `ldr rX, =expr`: load `expr` from literal pool
+// NB: `insn.name` is base name: `.W`, `.N` & condition codes are in `info`
+// NB: pool entry allocated as insn generated, not as stmt parsed
+template <typename ARGS_T, typename TRACE>
+auto arm_stmt_t::validate_args(insn_t const& insn
+                             , ARGS_T& args
+                             , bool& ok_for_quick
+                             , TRACE *trace
+                             ) -> kas_error_t
+{
+    for (auto& arg : args)
+        if (arg.mode() == MODE_LITERAL)
+        {
+            if (insn.name != "ldr" || arm_sfx_t::get_p(info.sfx_index))
+                return kas::parser::kas_diag_t::error("literal pool load requires ldr", arg).ref();
+
+            auto& addr = core::core_literal_pool::add(arg.expr);
+            arg.expr   = addr.ref(static_cast<kas::parser::kas_loc>(arg));
+            arg.set_mode(MODE_DIRECT);
+        }
+
+    return base_t::validate_args(insn, args, ok_for_quick, trace);
+}
+
 
 // NB: This method rejects single `MCODE` not `STMT`
 // NB: Doesn't process flags associted with LDR/STR statements
@@ -49,6 +75,17 @@ const char *arm_stmt_info_t::ok(arm_mcode_t const &mcode) const
         if (~m_info() & SZ_DEFN_S_FLAG)
             return "S flag not allowed";
 
+    // Thumb `.N` & `.W` qualifiers select encoding width
+    if (has_nflag || has_wflag)
+        if (auto arch = mcode.defn_arch(); arch == SZ_ARCH_THB16 || arch == SZ_ARCH_THB32)
+        {
+            auto is_wide = mcode.code_size() > sizeof(uint16_t);
+            if (has_nflag && is_wide)
+                return "narrow encoding not available";
+            if (has_wflag && !is_wide)
+                return "wide encoding required";
+        }
+
     // suffix tests should mirror defns in `arm_mcode.h`
     auto msg   = "suffix required";
     auto sfx_p = arm_sfx_t::get_p(sfx_index);
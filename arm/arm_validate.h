@@ -112,8 +112,10 @@ VAL_GEN(SAT5, val_range, 1, 32);
 //
 
 // These validators work with `opc_branch` opcode
+// NB: `BRANCH11` relaxes to `BRANCH24` (see `val_tmb_branch`)
 VAL_GEN(BRANCH8   , val_tmb_branch<8>);
-VAL_GEN(BRANCH11  , val_tmb_branch<11>);
+VAL_GEN(BRANCH11  , val_tmb_branch<11, true>);
+VAL_GEN(BRANCH24  , val_tmb_branch<24>);
 
 //
 // ARM5 addressing mode validators
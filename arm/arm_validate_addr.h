@@ -725,10 +725,20 @@ struct val_offset_8 : val_thumb_indir_base
 };
 
 // The `thb_branch*` validators work with the `arm_opc_branch` opcode
-template <unsigned BITS>
+//
+// Thumb branch displacements are `BITS`-bit signed halfword counts
+// calculated from PC (ie insn + 4).
+//
+// Narrow encodings are listed before wide encodings. If `RELAX` (ie a
+// wider encoding of the insn follows), report if displacement fits so
+// `core_relax` selects narrow form when possible. Otherwise emit reloc:
+// out-of-range displacement diagnosed by `kbfd` or handled by linker.
+template <unsigned BITS, bool RELAX = false>
 struct val_tmb_branch : arm_mcode_t::val_t
 {
-    // out-of-range displacement handled by linker
+    static constexpr auto disp_max = 1 << BITS;     // bytes
+    static constexpr auto disp_pc  = 4;             // PC is insn + 4
+    
     fits_result ok(arg_t& arg, expr_fits const& fits) const override
     {
         // NB: there is `reloc` available for unresolved branches
@@ -749,9 +759,12 @@ struct val_tmb_branch : arm_mcode_t::val_t
                    , expr_fits const& fits
                    , op_size_t& op_size) const override
     {
-        return fits.yes;
-    }
+        if constexpr (!RELAX)
+            return fits.yes;
 
+        // NB: constants & symbols in other sections are not displacements
+        return fits.disp(arg.expr, -disp_max, disp_max, disp_pc);
+    }
 };
 
 //using val_indir_pc_8 = val_offset_8;
@@ -34,10 +34,13 @@ using thumb_insn_common_l = list<list<>
 // Declare THUMB Instructions. Section references from ARM V5 ARchitecture Manual
 
 // ARM5: A6.3
-// NB: out-of-range branches handled by linker, not assembler
+// NB: narrow `b` listed first: relaxed to wide (T4) form when out-of-range
+// NB: wide (T4) `b` requires Thumb-2 (ARMv6T2)
+// NB: other out-of-range branches handled by linker, not assembler
 using thumb_insn_branch_l = list<list<>
 , defn<t16_u, STR("b")   , OP<0xe000>, FMT_TJU , BRANCH11>
 , defn<t16_c, STR("b")   , OP<0xd000>, FMT_TJC , BRANCH8>
+, defn<t16_u, STR("b")   , OP<0xf000'9000, hw::v6t2>, FMT_TJW, BRANCH24>
 , defn<t16_u, STR("bl")  , OP<0xf000'd000>, FMT_TC, DIRECT>
 , defn<t16_u, STR("blx") , OP<0xf000'c000>, FMT_TC, DIRECT>
 , defn<t16_u, STR("bx")  , OP<0x4700>, FMT_3I4 , REG>        //4-bit reg #
@@ -80,8 +80,8 @@ struct FMT_I9       : fmt_gen, fmt_arg<1, fmt16_generic<0, 9>> {};
 struct FMT_I8       : fmt_gen, fmt_arg<1, fmt16_generic<0, 8>> {};
 
 // Branches:
-struct FMT_TJU      : fmt_branch {}; //, fmt_arg<1, fmt_jump11> {};
-struct FMT_TJC      : fmt_branch {}; // , fmt_arg<1, fmt_jump8> {};
+struct FMT_TJU      : fmt_branch, fmt_arg<1, fmt_jump11> {};
+struct FMT_TJC      : fmt_branch, fmt_arg<1, fmt_jump8> {};
 struct FMT_TC       : fmt_branch, fmt_arg<1, fmt_thb_branch24<ARM_G1>> {};
 struct FMT_TJW      : fmt_branch, fmt_arg<1, fmt_thb_branch24<ARM_G2>> {};
 
@@ -48,6 +48,11 @@ struct fmt_indir5 : fmt16_generic<3, 8>
 
 // support R_ARM_THM_PC8 (op = ARM_REL_PC8)
 // designed for validator val_thm_pc8, INSNs: LDR(3), ADD(5)
+//
+// NB: offset is from Align(PC, 4). Insns are halfword aligned, so
+// Align(PC, 4) is either `dot + 4` or `dot + 2`. For word-aligned
+// targets (eg: literal pool entries), `(dest - (dot + 2)) >> 2` yields
+// the correct word offset in both cases.
 struct fmt_pc8 : fmt16_generic<0, 8>
 {
     using base_t = fmt16_generic<0, 8>;
@@ -61,45 +66,35 @@ struct fmt_pc8 : fmt16_generic<0, 8>
     void emit_reloc(core::core_emit& base, mcode_size_t* op, arg_t& arg, val_t const * val_p) const override
     {
         static kbfd::kbfd_reloc reloc { kbfd::ARM_REL_PC8(), 16, true };
-        base << core::emit_reloc(reloc) << arg.expr;
+        base << core::emit_reloc(reloc, {}, -2) << arg.expr;
     }
 };
 
-// XXX support R_ARM_THM_PC8 (op = ARM_REL_PC8)
-// XXX designed for validator val_thm_pc8, INSNs: LDR(3), ADD(5)
+// support R_ARM_THM_JUMP8 (op = ARM_REL_JUMP8)
+// designed for validator val_tmb_branch, INSNs: B<cond>
+// displacement is from PC (ie insn + 4)
 struct fmt_jump8 : fmt16_generic<0, 8>
 {
     using base_t = fmt16_generic<0, 8>;
-#if 0
-    bool insert(mcode_size_t* op, arg_t& arg, val_t const *val_p) const override
-    {
-        base_t::insert(op, arg, val_p);
-        return arg.get_fixed_p();       // need reloc if not fixed
-    }
-#endif
+
     void emit_reloc(core::core_emit& base, mcode_size_t* op, arg_t& arg, val_t const * val_p) const override
     {
-        static kbfd::kbfd_reloc reloc { kbfd::ARM_REL_PC8(), 16, true };
-        base << core::emit_reloc(reloc) << arg.expr;
+        static kbfd::kbfd_reloc reloc { kbfd::ARM_REL_JUMP8(), 16, true };
+        base << core::emit_reloc(reloc, {}, -4) << arg.expr;
     }
 };
 
-// XXX support R_ARM_THM_PC8 (op = ARM_REL_PC8)
-// XXX designed for validator val_thm_pc8, INSNs: LDR(3), ADD(5)
-struct fmt_jump11 : fmt16_generic<0, 8>
+// support R_ARM_THM_JUMP11 (op = ARM_REL_JUMP11)
+// designed for validator val_tmb_branch, INSNs: B
+// displacement is from PC (ie insn + 4)
+struct fmt_jump11 : fmt16_generic<0, 11>
 {
-    using base_t = fmt16_generic<0, 8>;
-#if 0
-    bool insert(mcode_size_t* op, arg_t& arg, val_t const *val_p) const override
-    {
-        base_t::insert(op, arg, val_p);
-        return arg.get_fixed_p();       // need reloc if not fixed
-    }
-#endif
+    using base_t = fmt16_generic<0, 11>;
+
     void emit_reloc(core::core_emit& base, mcode_size_t* op, arg_t& arg, val_t const * val_p) const override
     {
         static kbfd::kbfd_reloc reloc { kbfd::ARM_REL_JUMP11(), 16, true };
-        base << core::emit_reloc(reloc) << arg.expr;
+        base << core::emit_reloc(reloc, {}, -4) << arg.expr;
     }
 };
 
@@ -0,0 +1,687 @@
+#ifndef KAS_BSD_BSD_MACRO_H
+#define KAS_BSD_BSD_MACRO_H
+
+// bsd_macro: text expansion directives (`.macro`, `.irp`, `.irpc`, `.rept`)
+//
+// Macro bodies are split once, when defined, into segments: spans of the
+// defining source separated by parameter references (`\name`, `\@`, `\()`).
+// Expansion never re-scans the body:
+//
+//  - A body without references is parsed in place: a span of the defining
+//    source is pushed as a new `parser_src` object. No text is copied &
+//    diagnostics report the original file & line.
+//
+//  - Otherwise the segments & argument values are concatenated into a
+//    single buffer which is pushed. Arguments never hold line breaks, so
+//    buffer lines correspond to body lines. The buffer's line index is
+//    offset so diagnostics report the defining file & line.
+//
+// `.rept` (and `.irp` without references) push the body span in place with
+// a repeat count: each repetition restarts the span. `.rept` is a pseudo-op
+// (see `bsd_ops_core.h`) so the count may be an expression.
+//
+// `.macro`, `.irp` & `.irpc` are recognized by an X3 primitive parser
+// (`stmt_macro_x3`) as the statement text must be scanned directly.
+//
+// Bodies end at `.endm` or `.endr` (with nesting). Only directives which
+// begin a line are recognized when scanning a body. `.exitm` ends the
+// innermost expansion (including remaining `.rept` & `.irp` repetitions).
+//
+// Parameters may be qualified as in GNU `as`: `name:req` must be supplied
+// & `name:vararg` (last parameter) receives the remaining arguments.
+//
+// Macro invocation is checked for each statement: the first character is
+// tested against those of defined names before any lookup.
+//
+// Definitions & expansion buffers are never released during a run:
+// `kas_loc` values reference the text.
+
+#include "parser/parser_src.h"
+#include "parser/parser_scan.h"
+#include "parser/parser_stmt.h"
+#include "parser/parser_context.h"
+#include "kas_core/kas_clear.h"
+#include "kas/kas_string.h"
+
+#include <boost/spirit/home/x3.hpp>
+
+#include <bitset>
+#include <cctype>
+#include <deque>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace kas::bsd::macro
+{
+namespace x3 = boost::spirit::x3;
+using Iter = kas::parser::iterator_type;
+using kas::parser::parser_src;
+
+// limit nesting (eg: recursive macro)
+static constexpr auto max_depth = 64;
+
+//////////////////////////////////////////////////////////////////////////
+// Text scanning utilities
+//////////////////////////////////////////////////////////////////////////
+
+namespace detail
+{
+    using namespace kas::parser::detail;
+
+    // BSD identifier characters (see `bsd_parser_def.h`)
+    inline bool is_ident(char c)
+    {
+        return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '.';
+    }
+
+    inline Iter scan_ident(Iter it, Iter const& last)
+    {
+        if (it != last && !std::isdigit(static_cast<unsigned char>(*it)))
+            while (it != last && is_ident(*it))
+                ++it;
+        return it;
+    }
+
+    // match `.name` (case insensitive) not followed by identifier character
+    inline bool match_directive(Iter& first, Iter const& last, const char *name)
+    {
+        auto it = first;
+        if (it == last || *it++ != '.')
+            return false;
+        for (; *name; ++name, ++it)
+            if (it == last || std::tolower(static_cast<unsigned char>(*it)) != *name)
+                return false;
+        if (it != last && is_ident(*it))
+            return false;
+        first = it;
+        return true;
+    }
+
+    // advance to beginning of next line
+    inline void next_line(Iter& it, Iter const& last)
+    {
+        while (it != last && *it != '\n' && *it != '\r')
+            ++it;
+        scan_eol(it, last);
+    }
+
+    // advance to end of statement: comment, separator, or end-of-line
+    inline void scan_to_eos(Iter& it, Iter const& last)
+    {
+        auto comment   = kas::parser::stmt_comment{}();
+        auto separator = kas::parser::stmt_separator{}();
+        bool quoted {};
+
+        for (; it != last; ++it)
+        {
+            auto c = *it;
+            if (quoted)
+            {
+                if (c == '\\' && std::next(it) != last)
+                    ++it;
+                else if (c == '"')
+                    quoted = false;
+                continue;
+            }
+
+            if (c == '\n' || c == '\r')
+                break;
+            auto p = it;
+            if (scan_lit(p, last, comment) || scan_lit(p, last, separator))
+                break;
+            if (c == '"')
+                quoted = true;
+        }
+    }
+
+    // find body end. On success, `it` follows the closing directive &
+    // `body_last` is beginning of its line
+    inline bool find_end(Iter& it, Iter const& last, bool is_macro, Iter& body_last)
+    {
+        static constexpr const char *rept_ops[] = { "rept", "irp", "irpc" };
+
+        unsigned depth {};
+        for (auto p = it; p != last; next_line(p, last))
+        {
+            auto line = p;
+            scan_blanks(p, last);
+
+            bool opens {};
+            if (is_macro)
+                opens = match_directive(p, last, "macro");
+            else
+                for (auto op : rept_ops)
+                    opens = opens || match_directive(p, last, op);
+
+            if (opens)
+                ++depth;
+            else if (match_directive(p, last, is_macro ? "endm" : "endr") && !depth--)
+            {
+                body_last = line;
+                it = p;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // copy text with leading & trailing blanks removed
+    inline std::string trim(Iter first, Iter last)
+    {
+        while (last != first && (last[-1] == ' ' || last[-1] == '\t'))
+            --last;
+        scan_blanks(first, last);
+        return { first, last };
+    }
+
+    // extract argument: text to comma not in quotes or parens. trim blanks
+    // return true if comma follows (`first` is after comma)
+    inline bool next_arg(Iter& first, Iter const& last, std::string& arg)
+    {
+        unsigned parens {};
+        bool quoted {};
+        auto it = first;
+        for (; it != last; ++it)
+        {
+            auto c = *it;
+            if (quoted)
+            {
+                if (c == '\\' && std::next(it) != last)
+                    ++it;
+                else if (c == '"')
+                    quoted = false;
+            }
+            else if (c == '"')
+                quoted = true;
+            else if (c == '(')
+                ++parens;
+            else if (c == ')' && parens)
+                --parens;
+            else if (c == ',' && !parens)
+                break;
+        }
+
+        arg   = trim(first, it);
+        first = it;
+        if (it == last)
+            return false;
+        ++first;
+        return true;
+    }
+
+    // split arguments at commas not in quotes or parens. trim blanks
+    inline auto split_args(Iter first, Iter const& last)
+    {
+        std::vector<std::string> args;
+
+        scan_blanks(first, last);
+        if (first == last)
+            return args;
+
+        std::string arg;
+        while (next_arg(first, last, arg))
+            args.push_back(std::move(arg));
+        args.push_back(std::move(arg));
+        return args;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Macro body: split at parameter references
+//////////////////////////////////////////////////////////////////////////
+
+struct macro_body
+{
+    static constexpr int no_param    = -1;      // eg: `\()` separator
+    static constexpr int count_param = -2;      // `\@`
+
+    struct segment
+    {
+        Iter first;
+        Iter last;
+        int  param;     // reference following segment
+    };
+
+    macro_body() = default;
+    macro_body(Iter first, Iter last, std::vector<std::string> const& params)
+        : first(first), last(last)
+    {
+        auto seg = first;
+        for (auto it = first; it != last; )
+        {
+            if (*it != '\\')
+            {
+                ++it;
+                continue;
+            }
+
+            auto ref = it++;
+            if (it == last)
+                break;
+
+            int param;
+            if (*it == '@')
+            {
+                param = count_param;
+                ++it;
+            }
+            else if (*it == '(' && std::next(it) != last && it[1] == ')')
+            {
+                param = no_param;
+                it += 2;
+            }
+            else
+            {
+                // not a parameter: leave text as is (eg: string escapes)
+                auto name_end = detail::scan_ident(it, last);
+                auto p = std::find(params.begin(), params.end(), std::string(it, name_end));
+                if (name_end == it || p == params.end())
+                    continue;
+                param = p - params.begin();
+                it    = name_end;
+            }
+
+            segments.push_back({seg, ref, param});
+            seg = it;
+        }
+
+        if (!segments.empty())
+            segments.push_back({seg, last, no_param});
+    }
+
+    // body without references is parsed in place
+    bool in_place() const
+    {
+        return segments.empty();
+    }
+
+    // append body with references replaced
+    void expand(std::string& buf, std::vector<std::string> const& args, unsigned count) const
+    {
+        for (auto& seg : segments)
+        {
+            buf.append(seg.first, seg.last);
+            if (seg.param >= 0)
+                buf += args[seg.param];
+            else if (seg.param == count_param)
+                buf += std::to_string(count);
+        }
+    }
+
+    Iter first;
+    Iter last;
+    std::vector<segment> segments;
+};
+
+//////////////////////////////////////////////////////////////////////////
+// Macro definitions & expansion
+//////////////////////////////////////////////////////////////////////////
+
+struct bsd_macro
+{
+    // defined macros
+    // NB: called for each statement: reject by first character before lookup
+    static bsd_macro *find(std::string_view name)
+    {
+        if (name.empty() || !initials()[static_cast<unsigned char>(name[0])])
+            return nullptr;
+        auto it = macros().find(name);
+        return it == macros().end() ? nullptr : &it->second;
+    }
+
+    static bsd_macro *add(std::string const& name)
+    {
+        auto [it, inserted] = macros().try_emplace(name);
+        if (!inserted)
+            return nullptr;
+        initials().set(static_cast<unsigned char>(name[0]));
+        return &it->second;
+    }
+
+    // push `body` expanded once per arg list (`text` holds body)
+    static void push(parser_src::src_text const& text, macro_body const& body
+                   , std::vector<std::vector<std::string>> const& arg_lists)
+    {
+        if (body.first == body.last || arg_lists.empty())
+            return;
+
+        if (body.in_place())
+        {
+            parser_src::push(body.first, body.last, text, arg_lists.size());
+            return;
+        }
+
+        auto& buf = buffers().emplace_back();
+        for (auto& args : arg_lists)
+            body.expand(buf, args, count++);
+
+        // report lines relative to body in defining source
+        auto base   = text.lines->line(text.first, text.last, body.first) - 1;
+        auto period = text.lines->line(text.first, text.last, body.last) - 1 - base;
+        auto lines  = std::make_shared<kas::parser::x3_line_index>(base, period);
+        parser_src::push(buf.cbegin(), buf.cend()
+                       , parser_src::src_text{buf.cbegin(), buf.cend(), text.fname, lines});
+    }
+
+    std::vector<std::string> params;
+    std::vector<std::string> defaults;
+    std::vector<bool>        required;      // `:req`
+    bool                     vararg {};     // last parameter is `:vararg`
+    macro_body               body;
+    parser_src::src_text     text;
+
+private:
+    static std::map<std::string, bsd_macro, std::less<>>& macros()
+    {
+        static std::map<std::string, bsd_macro, std::less<>> macros_;
+        return macros_;
+    }
+
+    // first characters of defined names
+    static std::bitset<256>& initials()
+    {
+        static std::bitset<256> initials_;
+        return initials_;
+    }
+
+    static std::deque<std::string>& buffers()
+    {
+        static std::deque<std::string> buffers_;
+        return buffers_;
+    }
+
+    static void clear()
+    {
+        macros().clear();
+        initials().reset();
+        buffers().clear();
+        count = 0;
+    }
+
+    // value of `\@`: number of expansions
+    static inline unsigned count;
+    static inline core::kas_clear _c{clear};
+};
+
+//////////////////////////////////////////////////////////////////////////
+// X3 parser for `.macro`, `.irp`, `.irpc` & macro invocation
+//////////////////////////////////////////////////////////////////////////
+
+struct bsd_macro_parser : x3::parser<bsd_macro_parser>
+{
+    using attribute_type = kas::parser::parser_stmt *;
+    static bool const has_attribute = true;
+
+    template <typename Context, typename RContext, typename Attribute>
+    bool parse(Iter& first, Iter const& last
+             , Context const& ctx, RContext&, Attribute& attr) const
+    {
+        using namespace detail;
+
+        x3::skip_over(first, last, ctx);
+        auto it = first;
+        const char *err {};
+
+        if (it == last)
+            return false;
+        else if (*it != '.')
+        {
+            if (!invoke(it, last, err))
+                return false;
+        }
+        else if (match_directive(it, last, "macro"))
+            err = define(it, last);
+        else if (match_directive(it, last, "irp"))
+            err = irp(it, last, false);
+        else if (match_directive(it, last, "irpc"))
+            err = irp(it, last, true);
+        else if (match_directive(it, last, "exitm"))
+        {
+            // expansion ends after this line
+            auto line_end = it;
+            next_line(line_end, last);
+            if (!parser_src::exit(line_end))
+                err = "not in macro expansion";
+        }
+        else if (match_directive(it, last, "endm") || match_directive(it, last, "endr"))
+            err = "unmatched end of block";
+        else if (!invoke(it, last, err))
+            return false;
+
+        if (err)
+        {
+            // skip to end of statement so error is only diagnostic
+            scan_to_eos(it, last);
+            kas::parser::kas_position_tagged loc { first, it, &x3::get<kas::parser::error_handler_tag>(ctx) };
+            x3::get<kas::parser::error_diag_tag>(ctx).err_idx = kas::parser::kas_diag_t::error(err, loc).ref();
+        }
+
+        first = it;
+        attr  = kas::parser::impl::stmt_nop<core::opc::opc_nop<KAS_STRING("MACRO")>>()();
+        return true;
+    }
+
+private:
+    // parse `name [param[:qual][=default]][[,] param...]` & body
+    static const char *define(Iter& it, Iter const& last)
+    {
+        using namespace detail;
+
+        scan_blanks(it, last);
+        auto name_end = scan_ident(it, last);
+        if (name_end == it)
+            return "macro name required";
+        std::string name(it, name_end);
+        it = name_end;
+
+        std::vector<std::string> params, defaults;
+        std::vector<bool> required;
+        bool vararg {};
+        for (;;)
+        {
+            while (it != last && (*it == ' ' || *it == '\t' || *it == ','))
+                ++it;
+            auto p = it;
+            scan_to_eos(p, last);
+            if (p == it)
+                break;
+
+            auto param_end = scan_ident(it, last);
+            if (param_end == it)
+                return "invalid macro parameter";
+            if (vararg)
+                return "vararg parameter must be last";
+            params.emplace_back(it, param_end);
+            it = param_end;
+
+            // qualifier: `:req` or `:vararg`
+            bool req {};
+            if (it != last && *it == ':')
+            {
+                auto qual_end = scan_ident(++it, last);
+                std::string qual(it, qual_end);
+                if (qual == "req")
+                    req = true;
+                else if (qual == "vararg")
+                    vararg = true;
+                else
+                    return "invalid parameter qualifier";
+                it = qual_end;
+            }
+            required.push_back(req);
+
+            auto& value = defaults.emplace_back();
+            scan_blanks(it, last);
+            if (it != last && *it == '=')
+            {
+                scan_blanks(++it, last);
+                auto value_first = it;
+                while (it != p && *it != ',' && *it != ' ' && *it != '\t')
+                    ++it;
+                value.assign(value_first, it);
+            }
+        }
+
+        auto body_first = it;
+        next_line(body_first, last);
+        auto body_end = body_first;
+        Iter body_last;
+        if (!find_end(body_end, last, true, body_last))
+            return "missing .endm";
+
+        // position after `.endm`: remainder of line is end-of-statement
+        it = body_end;
+
+        auto def = bsd_macro::add(name);
+        if (!def)
+            return "macro already defined";
+
+        def->body     = { body_first, body_last, params };
+        def->params   = std::move(params);
+        def->defaults = std::move(defaults);
+        def->required = std::move(required);
+        def->vararg   = vararg;
+        def->text     = parser_src::text();
+        return {};
+    }
+
+    // parse `.irp sym, values...` or `.irpc sym, chars` & body
+    static const char *irp(Iter& it, Iter const& last, bool is_irpc)
+    {
+        using namespace detail;
+
+        auto args_first = it;
+        scan_to_eos(it, last);
+        auto args = split_args(args_first, it);
+        if (args.empty() || scan_ident(args[0].cbegin(), args[0].cend()) != args[0].cend())
+            return "symbol required";
+
+        auto body_first = it;
+        next_line(body_first, last);
+        auto body_end = body_first;
+        Iter body_last;
+        if (!find_end(body_end, last, false, body_last))
+            return "missing .endr";
+
+        if (parser_src::depth() >= max_depth)
+            return "blocks nested too deeply";
+
+        // one expansion per value. If no values, expand once with empty value
+        std::vector<std::vector<std::string>> arg_lists;
+        if (is_irpc)
+        {
+            if (args.size() > 2)
+                return "too many arguments";
+            if (args.size() == 1 || args[1].empty())
+                arg_lists.push_back({""});
+            else
+                for (auto c : args[1])
+                    arg_lists.push_back({std::string(1, c)});
+        }
+        else if (args.size() == 1)
+            arg_lists.push_back({""});
+        else
+            for (auto p = std::next(args.begin()); p != args.end(); ++p)
+                arg_lists.push_back({*p});
+
+        // next statement parsed is first expansion, then text after `.endr`
+        bsd_macro::push(parser_src::text(), { body_first, body_last, {args[0]} }, arg_lists);
+        it = body_end;
+        return {};
+    }
+
+    // parse `name [arg][, arg...]`. Return false if not macro invocation
+    static bool invoke(Iter& it, Iter const& last, const char *& err)
+    {
+        using namespace detail;
+
+        auto name_end = scan_ident(it, last);
+        if (name_end == it)
+            return false;
+
+        auto def = bsd_macro::find({&*it, static_cast<std::size_t>(name_end - it)});
+        if (!def)
+            return false;
+
+        // not label or assignment
+        auto p = name_end;
+        scan_blanks(p, last);
+        if (p != last && (*p == ':' || *p == '='))
+            return false;
+
+        it = name_end;
+        auto args_first = it;
+        scan_to_eos(it, last);
+
+        // positional & keyword args. Missing args take default values
+        // NB: vararg parameter takes text of remaining args
+        auto values = def->defaults;
+        std::vector<bool> given(values.size());
+        unsigned n {};
+        std::string arg;
+        bool more {};
+        scan_blanks(args_first, it);
+        for (auto arg_it = args_first; arg_it != it || more; )
+        {
+            auto arg_first = arg_it;
+            more = next_arg(arg_it, it, arg);
+
+            auto kw_end = scan_ident(arg.cbegin(), arg.cend());
+            auto eq     = kw_end;
+            while (eq != arg.cend() && (*eq == ' ' || *eq == '\t'))
+                ++eq;
+            if (kw_end != arg.cbegin() && eq != arg.cend() && *eq == '=')
+            {
+                auto& params = def->params;
+                auto kw = std::find(params.begin(), params.end()
+                                  , std::string(arg.cbegin(), kw_end));
+                if (kw != params.end())
+                {
+                    auto value = std::next(eq);
+                    while (value != arg.cend() && (*value == ' ' || *value == '\t'))
+                        ++value;
+                    values[kw - params.begin()].assign(value, arg.cend());
+                    given[kw - params.begin()] = true;
+                    continue;
+                }
+            }
+
+            if (n >= values.size())
+            {
+                err = "too many arguments";
+                return true;
+            }
+            if (def->vararg && n + 1 == values.size())
+            {
+                values[n] = trim(arg_first, it);
+                given[n]  = true;
+                break;
+            }
+            if (!arg.empty())
+            {
+                values[n] = arg;
+                given[n]  = true;
+            }
+            ++n;
+        }
+
+        for (unsigned i = 0; i < given.size(); ++i)
+            if (def->required[i] && !given[i])
+            {
+                err = "required macro argument missing";
+                return true;
+            }
+
+        if (parser_src::depth() >= max_depth)
+            err = "macros nested too deeply";
+        else
+            bsd_macro::push(def->text, def->body, {values});
+        return true;
+    }
+};
+
+}
+
+#endif
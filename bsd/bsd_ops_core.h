@@ -3,10 +3,14 @@
 
 #include "kas_core/opcode.h"
 #include "kas_core/opc_misc.h"
+#include "kas_core/opc_incbin.h"
 #include "kas_core/opc_fixed.h"
 #include "kas_core/core_section.h"
 #include "kas_core/core_symbol.h"
+#include "parser/parser_include.h"
+#include "bsd_macro.h"
 
+#include <limits>
 #include <ostream>
 
 namespace kas::bsd
@@ -98,6 +102,214 @@ struct bsd_skip : bsd_opcode
     }
 };
 
+// arg format: repeat [, size [, value]]
+// NB: if `num_v[0]` specified, it is size: `.space` format is: repeat [, value]
+struct bsd_fill : bsd_opcode
+{
+    static inline opc_fill base_op;
+
+    void bsd_proc_args(data_t& data, bsd_args&& args
+                     , short arg_c
+                     , const char  **str_v
+                     , short const *num_v
+                     ) const override
+    {
+        if (auto result = validate_min_max(args, 1, arg_c ? 2 : 3))
+            return make_error(data, result);
+
+        // args must be fixed. default: size = 1, value = 0
+        int64_t repeat {}, size = arg_c ? num_v[0] : 1, value {};
+        int64_t *dest[] = { &repeat, arg_c ? &value : &size, &value };
+        for (unsigned i = 0; i < args.size(); ++i)
+        {
+            auto p = args[i].get_fixed_p();
+            if (!p)
+                return make_error(data, "fixed value required", args[i]);
+            *dest[i] = *p;
+        }
+
+        if (repeat < 0 || repeat > std::numeric_limits<uint32_t>::max())
+            return make_error(data, "invalid repeat count", args[0]);
+        if (size < 0)
+            return make_error(data, "invalid fill size", args[1]);
+
+        // NB: as GNU, size over 8 is 8 & size of zero emits nothing
+        if (size > 8)
+        {
+            auto& loc = *args[1].template get_p<kas::parser::kas_loc>();
+            kas::parser::kas_diag_t::warning(".fill size clamped to 8", loc);
+            size = 8;
+        }
+        else if (size == 0)
+            size = 1, repeat = 0;
+
+        // NB: as GNU, value is truncated to 32 bits
+        base_op.proc_args(data, value, size, repeat);
+    }
+
+    opcode const& op() const override
+    {
+        return base_op;
+    }
+};
+
+// arg format: "file" [, skip [, count]]
+struct bsd_incbin : bsd_opcode
+{
+    static inline opc_incbin base_op;
+
+    void bsd_proc_args(data_t& data, bsd_args&& args
+                     , short arg_c
+                     , const char  **str_v
+                     , short const *num_v
+                     ) const override
+    {
+        if (auto result = validate_min_max(args, 1, 3))
+            return make_error(data, result);
+
+        auto name_p = args[0].template get_p<e_string_t>();
+        if (!name_p)
+            return make_error(data, "file name required", args[0]);
+
+        // skip & count must be fixed & non-negative
+        int64_t values[2] = { 0, -1 };
+        for (unsigned i = 1; i < args.size(); ++i)
+        {
+            auto p = args[i].get_fixed_p();
+            if (!p || *p < 0)
+                return make_error(data, "fixed non-negative value required", args[i]);
+            values[i - 1] = *p;
+        }
+
+        const char *err {};
+        auto file = core::core_incbin::add((*name_p)(), err);
+        if (!file)
+            return make_error(data, err, args[0]);
+
+        // default count is remainder of file
+        int64_t size = core::core_incbin::get(file).file_size();
+        auto skip    = values[0];
+        auto count   = values[1];
+        if (skip > size)
+            return make_error(data, "skip exceeds file size", args[1]);
+        if (count < 0)
+            count = size - skip;
+        else if (skip + count > size)
+            return make_error(data, "count exceeds file size", args[2]);
+
+        base_op.proc_args(data, file, skip, count);
+    }
+
+    opcode const& op() const override
+    {
+        return base_op;
+    }
+};
+
+// arg format: "file"
+struct bsd_include : bsd_opcode
+{
+    OPC_INDEX();
+
+    const char *name() const override { return "INCLUDE"; }
+
+    // limit nesting (eg: file includes itself)
+    static constexpr auto max_depth = 64;
+
+    void bsd_proc_args(data_t& data, bsd_args&& args
+                     , short arg_c
+                     , const char  **str_v
+                     , short const *num_v
+                     ) const override
+    {
+        using kas::parser::parser_include;
+
+        if (auto err = validate_min_max(args, 1, 1))
+            return make_error(data, err);
+
+        auto name_p = args[0].template get_p<e_string_t>();
+        if (!name_p)
+            return make_error(data, "file name required", args[0]);
+
+        if (kas::parser::parser_src::depth() >= max_depth)
+            return make_error(data, "include files nested too deeply", args[0]);
+
+        auto file_p = parser_include::find((*name_p)());
+        if (!file_p)
+            return make_error(data, "include file not found", args[0]);
+
+        // next statement parsed is first in included file
+        parser_include::push(*file_p);
+        auto& di = data.di();
+        *di++ = std::move(args[0].expr());
+    }
+
+    void fmt(data_t const& data, std::ostream& os) const override
+    {
+        os << *data.iter();
+    }
+
+    opcode const& op() const override
+    {
+        return *this;
+    }
+};
+
+// arg format: count
+// NB: body follows statement: consumed through `.endr` (see `bsd_macro.h`)
+struct bsd_rept : bsd_opcode
+{
+    OPC_INDEX();
+
+    const char *name() const override { return "REPT"; }
+
+    void bsd_proc_args(data_t& data, bsd_args&& args
+                     , short arg_c
+                     , const char  **str_v
+                     , short const *num_v
+                     ) const override
+    {
+        using kas::parser::parser_src;
+
+        if (auto err = validate_min_max(args, 1, 1))
+            return make_error(data, err);
+
+        auto p = args[0].get_fixed_p();
+        if (!p || *p < 0)
+            return make_error(data, "fixed non-negative count required", args[0]);
+
+        // body begins on line following statement
+        auto body_first = parser_src::iter();
+        auto body_end   = body_first;
+        macro::Iter body_last;
+        if (!macro::detail::find_end(body_end, parser_src::last(), false, body_last))
+            return make_error(data, "missing .endr", args[0]);
+
+        if (parser_src::depth() >= macro::max_depth)
+            return make_error(data, "blocks nested too deeply", args[0]);
+
+        // resume after `.endr` once repeats complete. push body in place
+        // NB: current object must be updated before push
+        auto text = parser_src::text();
+        parser_src::iter() = body_end;
+        if (*p && body_first != body_last)
+            parser_src::push(body_first, body_last, text, *p);
+
+        auto& di = data.di();
+        *di++ = std::move(args[0].expr());
+    }
+
+    void fmt(data_t const& data, std::ostream& os) const override
+    {
+        os << *data.iter();
+    }
+
+    opcode const& op() const override
+    {
+        return *this;
+    }
+};
+
 // front-end for `core_fixed` opcodes with BSD args
 template <typename T>
 struct bsd_fixed : bsd_opcode
@@ -15,7 +15,9 @@
 // required `kas_core` includes are in core header
 
 #include "bsd_arg_defn.h"
+#include "bsd_ops_core.h"
 #include "kas_core/opc_segment.h"
+#include "kas_core/opc_merge.h"
 
 namespace kas::bsd
 {
@@ -195,6 +197,40 @@ struct bsd_subsection : bsd_section_base
 };
 
 
+
+// null-terminated string: pooled if section is mergeable string section
+// NB: only single string args are pooled (see `opc_merge.h`)
+struct bsd_asciz : bsd_fixed<core::opc::opc_string<std::true_type>>
+{
+    using base_t = bsd_fixed<core::opc::opc_string<std::true_type>>;
+    static inline core::opc::opc_merge_ref merge_op;
+
+    void bsd_proc_args(data_t& data, bsd_args&& args
+                     , short arg_c
+                     , const char  **str_v
+                     , short const *num_v
+                     ) const override
+    {
+        // NB: section is chosen when insn is inserted (see `opc_merge.h`)
+        e_string_t const *str_p {};
+        if (args.size() == 1)
+            str_p = args[0].template get_p<e_string_t>();
+
+        if (!str_p)
+            return base_t::bsd_proc_args(data, std::move(args), arg_c, str_v, num_v);
+
+        merge_op.proc_args(data, (*str_p)());
+    }
+
+    // pooled string size is {0, length} until placed. `opc_string` is fixed size
+    opcode const& select_op(data_t const& data) const override
+    {
+        if (data.size.is_relaxed())
+            return base_t::op();
+        return merge_op;
+    }
+};
+
 }
 
 
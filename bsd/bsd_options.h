@@ -4,6 +4,7 @@
 
 #include "program_options/po_defn.h"
 #include "expr/expr_types.h"
+#include "parser/parser_include.h"
 
 #include <list>
 
@@ -11,7 +12,6 @@ namespace kas::bsd
 {
 
 struct {
-    std::list<const char *> m_include_path;
     std::list<const char *> m_predefined;
     bool    m_alternate;
     bool    m_no_preprocessing;
@@ -25,11 +25,12 @@ struct add_bsd_options
     void operator()(options::po_defns& defns) const
     {
         auto& o = bsd_options;
+        auto& i = kas::parser::parser_include::search_path;
         defns.add()
             ("--alternate"            , "initially turn on alternate macro syntax"  , o.m_alternate)
             ("-I,@DIR,."              , "add DIR to search list for .include directives"
-                                                                                    , o.m_include_path)
-            ("-I-"                    , "clear .include search list"                , o.m_include_path)
+                                                                                    , i)
+            ("-I-"                    , "clear .include search list"                , i)
             ("--MD,:FILE"             , "write dependency information in FILE")
             ("-f"                     , "skip whitespace and comment preprocessing" , o.m_no_preprocessing)
             ("--defsym,@SYM[=VALUE]"  , "define symbol SYM to given VALUE [default: 1]"
@@ -175,14 +175,16 @@ auto const stmt_comma_def = (comma_op > comma_args)[bsd_stmt_pseudo()];
 auto const stmt_space_def = (space_op > space_args)[bsd_stmt_pseudo()]; 
 auto const stmt_equ_def   = ((label           >> '=') > space_arg)[bsd_stmt_equ()];
 auto const stmt_org_def   = ((omit[dot_ident] >> '=') > space_arg)[bsd_stmt_org()];
+auto const stmt_macro_def = macro::bsd_macro_parser();
 
 // Boilerplate to instantiate top-level parsers
 stmt_comma_x3  stmt_comma   {"bsd_comma"};
 stmt_space_x3  stmt_space   {"bsd_space"};
 stmt_equ_x3    stmt_equ     {"bsd_equ"  };
 stmt_org_x3    stmt_org     {"bsd_org"  };
+stmt_macro_x3  stmt_macro   {"bsd_macro"};
 
-BOOST_SPIRIT_DEFINE(stmt_comma, stmt_space, stmt_equ, stmt_org)
+BOOST_SPIRIT_DEFINE(stmt_comma, stmt_space, stmt_equ, stmt_org, stmt_macro)
 }
 
 #endif
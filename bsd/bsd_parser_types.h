@@ -23,9 +23,10 @@ using stmt_space_x3 = x3::rule<class _tag_space , bsd::bsd_stmt_pseudo *>;
 using stmt_equ_x3   = x3::rule<class _tag_equ   , bsd::bsd_stmt_equ *>;
 using stmt_org_x3   = x3::rule<class _tag_org   , bsd::bsd_stmt_org *>;
 using stmt_label_x3 = x3::rule<class _tag_lbl   , bsd::bsd_stmt_label *>;
+using stmt_macro_x3 = x3::rule<class _tag_macro , kas::parser::parser_stmt *>;
 
 BOOST_SPIRIT_DECLARE(stmt_space_x3, stmt_comma_x3)
-BOOST_SPIRIT_DECLARE(stmt_equ_x3, stmt_org_x3, stmt_label_x3)
+BOOST_SPIRIT_DECLARE(stmt_equ_x3, stmt_org_x3, stmt_label_x3, stmt_macro_x3)
 
 }
 
@@ -43,8 +44,10 @@ template <> struct label_ops_l<defn_fmt> : meta::list<
         > {};
 
 // parsers for non-label statements
+// NB: `stmt_macro` first: macro invocation looks like other statements
 template <> struct stmt_ops_l<defn_fmt> : meta::list<
-          bsd::parser::bnf::stmt_comma_x3
+          bsd::parser::bnf::stmt_macro_x3
+        , bsd::parser::bnf::stmt_comma_x3
         , bsd::parser::bnf::stmt_space_x3
         , bsd::parser::bnf::stmt_equ_x3
         , bsd::parser::bnf::stmt_org_x3
@@ -25,6 +25,13 @@ struct bsd_opcode : core::opc::opc_nop<KAS_STRING("BSD_OPCODE")>
 
     // get base opcode type
     virtual core::opc::opcode const& op() const = 0;
+
+    // get opcode for processed args. default: base opcode
+    // NB: allows `bsd_proc_args` to choose opcode via `data` (eg: `.asciz`)
+    virtual core::opc::opcode const& select_op(data_t const& data) const
+    {
+        return op();
+    }
 };
 
 
@@ -91,7 +91,7 @@ namespace detail
                     *p++ = num_v[n++];
             }
             op.bsd_proc_args(data, std::move(args), arg_c, str_v.data(), short_v);
-            return &op.op();
+            return &op.select_op(data);
         }
         
         uint8_t name_idx;
@@ -180,8 +180,6 @@ using bsd_fixed_cmds = list<
 , list<STR("uleb128"),      opc_uleb128>
 
 , list<STR("ascii"),        opc_string<std::false_type>>
-, list<STR("asciz"),        opc_string<std::true_type>>
-, list<STR("string"),       opc_string<std::true_type>>
 
 , list<STR("string8"),      opc_string<std::true_type, std::uint8_t>>
 , list<STR("string16"),     opc_string<std::true_type, std::uint16_t>>
@@ -209,6 +207,11 @@ template<> struct comma_ops_v<bsd_float_tag> : list<
 > {};
 #endif
 
+// text expansion ops (`.macro`, `.irp`: see `bsd_macro.h`)
+template<> struct comma_ops_v<bsd_macro_tag> : list<
+  list<STR("rept"),         bsd_rept>
+> {};
+
 template<> struct comma_ops_v<bsd_basic_tag> : list<
 // section ops
   list<STR("section"),      bsd_section>
@@ -228,6 +231,16 @@ template<> struct comma_ops_v<bsd_basic_tag> : list<
 , list<STR("align"),        bsd_align>
 , list<STR("even"),         bsd_align, _ONE>
 
+// data ops
+, list<STR("asciz"),        bsd_asciz>
+, list<STR("string"),       bsd_asciz>
+, list<STR("fill"),         bsd_fill>
+, list<STR("space"),        bsd_fill, _ONE>
+, list<STR("incbin"),       bsd_incbin>
+
+// source ops
+, list<STR("include"),      bsd_include>
+
 // symbol ops
 , list<STR("local"),        bsd_sym_binding, _STB_LOCAL>
 , list<STR("globl"),        bsd_sym_binding, _STB_GLOBAL>
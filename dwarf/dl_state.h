@@ -2,26 +2,27 @@
 #define KAS_DWARF_DL_STATE_H
 
 #include "dwarf_line_data.h"
-#include "expr/expr_leb.h"
+#include "kas_core/kas_clear.h"
 #include "meta/meta.hpp"
 
+#include <algorithm>
+#include <vector>
+
 //
 // data structures to hold dwarf_line information
 //
-// create a "kas_object" instance to hold "line #" & count of additional
-// attributes for each ".loc" pseudo-op instruction.
-//
-// create single "uint8_t" deque to hold other-than-line attributes for
-// all instructions. each "attribute" is stored as a leb128 attribute number,
-// followed by a leb128 value. A "count" of attributes added by each ".loc"
-// is stored in each ".loc" instance.
+// `dwarf_line` information is held in a packed column store: one row for
+// each ".loc" pseudo-op instruction. Each column is a separate `vector`,
+// appended as ".loc" insns are parsed, & read sequentially when the
+// dwarf line program is generated.
 //
-// With this arrangement, it is only possible to read the dwarf_line information
-// from beginning to end. Fortunately, this is the only way the information is 
-// read.
+// The common attributes (line, file, column & boolean flags) are stored
+// in fixed width columns. Uncommon attributes (isa, discriminator, etc) &
+// values too large for their column are stored as (row, key, value)
+// triples in the `extra` column.
 //
-// The `address` of each instance is updated during `emit`. The `address` is used
-// when the dwarf line program is generated after the main data emitted.
+// The `address` & `segment` of each row are updated during `emit`.
+// `dl_data` instances are lightweight row references.
 //
 
 namespace kas::dwarf
@@ -30,90 +31,172 @@ namespace kas::dwarf
 template <typename Inserter>
 void dwarf_gen(Inserter&& inserter);
 
-struct dl_data : core::kas_object<dl_data>
+struct dl_data
 {
     using dl_value_t = uint32_t;
-    using dl_pair = std::pair<uint8_t, dl_value_t>;
-    using leb128  = expression::sleb128<dl_value_t>;
+    using dl_pair    = std::pair<uint8_t, dl_value_t>;
+    using index_t    = uint32_t;
     
     using NAME = KAS_STRING("dl_data");
 
 private:
-    static auto& dl_values()
+    // `flags` column: boolean attributes
+    enum : uint8_t
     {
-        static auto values_ = new std::deque<uint8_t>;
-        return *values_;
-    }
+          F_IS_STMT        = 1 << 0     // value of `is_stmt`
+        , F_SET_IS_STMT    = 1 << 1     // `is_stmt` specified
+        , F_BASIC_BLOCK    = 1 << 2
+        , F_END_SEQUENCE   = 1 << 3
+        , F_PROLOGUE_END   = 1 << 4
+        , F_EPILOGUE_BEGIN = 1 << 5
+        , F_EXTRA          = 1 << 6     // row has `extra` values
+    };
+
+    struct dl_columns
+    {
+        std::vector<uint32_t> line;
+        std::vector<uint32_t> address;  // XXX should be 32-bit/64-bit based on address
+        std::vector<uint16_t> file;     // zero if unspecified
+        std::vector<uint16_t> column;   // zero if unspecified
+        std::vector<uint8_t>  segment;  // XXX should be ref::index_t
+        std::vector<uint8_t>  flags;
 
-    // reset "reader" before each of the "for_each" functions
-    static auto& dl_reader(bool re_init = false)
+        // uncommon values: in row order
+        std::vector<std::pair<index_t, dl_pair>> extra;
+    };
+
+    static auto& cols()
     {
-        static auto reader = dl_values().begin();
-        if (re_init)
-            reader = dl_values().begin();
-        return reader;
+        static dl_columns cols_;
+        return cols_;
     }
 
 public:
-
-    // ctor: record actions for each "dwarf_line" operation
-    dl_data(dl_value_t file_num, dl_value_t line_num, dl_pair const* values, uint32_t n)
-        : dl_line_num(line_num)
+    // row reference: `index` is 1-based (as `kas_object`)
+    dl_data(index_t index) : row(index - 1) {}
+    
+    // record actions for each "dwarf_line" operation
+    static dl_data add(dl_value_t file_num, dl_value_t line_num
+                     , dl_pair const* values, uint32_t n)
     {
-        // Don't record "file" in instance. It changes so infrequently
-        // that it is better stored as data. Code as special case.
-        
-        // don't create inserter if no change except line #
-        if (n || file_num != this->file_num)
-        {
-            auto inserter = std::back_inserter(dl_values());
-            auto fn = [&inserter](auto n) { *inserter++ = n; };
-            if (file_num != this->file_num) 
+        auto& c   = cols();
+        index_t row = c.line.size();
+        uint8_t  flags  {};
+        uint16_t column {};
+
+        auto add_extra = [&](uint8_t key, dl_value_t value)
             {
-                ++cnt;
-                this->file_num = file_num;
-                *inserter++ = DL_file;
-                leb128::write(fn, file_num);
-            }
+                c.extra.push_back({ row, { key, value } });
+                flags |= F_EXTRA;
+            };
+        auto add_flag  = [&](uint8_t key, dl_value_t value, uint8_t flag)
+            {
+                if (value == 1)
+                    flags |= flag;
+                else
+                    add_extra(key, value);
+            };
 
-            for(; n--; ++values)
+        if (file_num > UINT16_MAX)
+        {
+            add_extra(DL_file, file_num);
+            file_num = 0;
+        }
+
+        for (; n--; ++values)
+        {
+            auto [key, value] = *values;
+            switch (key)
             {
-                ++cnt;
-                *inserter++ = values->first;
-                //if (!dl_is_bool[values->first]
-                    leb128::write(fn, values->second);
+            case DL_column:
+                if (value && value <= UINT16_MAX)
+                    column = value;
+                else
+                    add_extra(key, value);
+                break;
+            case DL_is_stmt:
+                flags &= ~F_IS_STMT;
+                flags |= F_SET_IS_STMT | (value ? F_IS_STMT : 0);
+                break;
+            case DL_basic_block:
+                add_flag(key, value, F_BASIC_BLOCK);
+                break;
+            case DL_end_sequence:
+                add_flag(key, value, F_END_SEQUENCE);
+                break;
+            case DL_prologue_end:
+                add_flag(key, value, F_PROLOGUE_END);
+                break;
+            case DL_epilogue_begin:
+                add_flag(key, value, F_EPILOGUE_BEGIN);
+                break;
+            default:
+                add_extra(key, value);
+                break;
             }
         }
+
+        c.line   .push_back(line_num);
+        c.address.push_back({});
+        c.file   .push_back(file_num);
+        c.column .push_back(column);
+        c.segment.push_back({});
+        c.flags  .push_back(flags);
+        return row + 1;
     }
     
-    static auto size()
+    static dl_data get(index_t index)
     {
-        return obstack().size();
+        return index;
+    }
+
+    static index_t size()
+    {
+        return cols().line.size();
     }
     
-    // apply all dl_data (except line# & address)
-    // NB: assumes in middle of "for_each" & dl_reader is properly set
-    using apply_fn = void(*)(uint8_t dl_enum, dl_value_t dl_value);
+    index_t index() const { return row + 1; }
+
+    // apply all attributes (except line# & address) in canonical order
     template <typename FN>
-    void do_apply(FN&& apply_fn) const
+    void do_apply(FN&& fn) const
     {
-        if (cnt) {
-            auto& reader = dl_reader();
-            auto  read_fn = [&reader]() { return *reader++; };
-            auto  n = cnt;
-
-            while (n--) {
-                auto dl_enum  = *reader++;
-                auto dl_value = leb128::read(read_fn);
-                apply_fn(dl_enum, dl_value);
-            }
+        auto& c = cols();
+        auto apply_fn = [&fn](uint8_t key, dl_value_t value) { fn(key, value); };
+        
+        if (auto file = c.file[row])
+            apply_fn(DL_file, file);
+        if (auto column = c.column[row])
+            apply_fn(DL_column, column);
+
+        auto flags = c.flags[row];
+        if (!flags)
+            return;
+
+        if (flags & F_SET_IS_STMT)
+            apply_fn(DL_is_stmt, !!(flags & F_IS_STMT));
+        if (flags & F_BASIC_BLOCK)
+            apply_fn(DL_basic_block, 1);
+        if (flags & F_END_SEQUENCE)
+            apply_fn(DL_end_sequence, 1);
+        if (flags & F_PROLOGUE_END)
+            apply_fn(DL_prologue_end, 1);
+        if (flags & F_EPILOGUE_BEGIN)
+            apply_fn(DL_epilogue_begin, 1);
+        
+        if (flags & F_EXTRA)
+        {
+            auto iter = std::lower_bound(c.extra.begin(), c.extra.end(), row
+                                , [](auto& e, index_t row) { return e.first < row; });
+            for (; iter != c.extra.end() && iter->first == row; ++iter)
+                apply_fn(iter->second.first, iter->second.second);
         }
     }
 
     // allow address & line# to be directly retrieved
-    auto  line_num() const { return dl_line_num; }
-    auto& address ()       { return dl_address;  }
-    auto& segment ()       { return dl_segment;  }
+    auto  line_num() const { return cols().line[row];    }
+    auto& address ()       { return cols().address[row]; }
+    auto& segment ()       { return cols().segment[row]; }
 
     // expose lookup function from DL_STATE...
     static constexpr auto lookup = DL_STATE::lookup;
@@ -123,63 +206,66 @@ public:
     static void mark_end(core::core_segment const& seg)
     {
         dl_pair value{DL_end_sequence, true};
-        auto& d = add(file_num, 0, &value, 1);
+        auto d = add(0, 0, &value, 1);
         d.segment() = seg.index();
         d.address() = seg.size()();
     }
 
-    // override `base_t` methods to reset "reader" funtion
+    // read rows sequentially
     template <typename FN>
     static void for_each(FN fn)
     {
-        dl_reader(true);    // re-init reader
-        base_t::for_each(fn);
+        for (index_t index = 1, n = size(); index <= n; ++index)
+        {
+            dl_data d{index};
+            fn(d);
+        }
     }
 
     template <typename OS>
     static void dump(OS& os)
     {
-        std::cout << "DW_STATE: dump: cout = " << obstack().size() << std::endl;
-        dl_reader(true);
-        base_t::dump(os);
+        os << "dump: " << NAME::value;
+        for_each([&os](auto& d)
+            {
+                os << std::endl;
+                os << std::dec << std::right;
+                os << std::setw(4) << d.index() << ": ";
+                d.dump_one(os);
+            });
+        os << '\n' << std::endl;
     }
 
     template <typename OS>
     void dump_one(OS& os) const
     {
-        os << std::right << std::setw(4) << dl_line_num;
+        os << std::right << std::setw(4) << line_num();
 
-        if (dl_segment) {
-            os << " " << core::core_segment::get(dl_segment) << "+";
-            os << std::hex << dl_address;
+        if (auto seg = cols().segment[row]) {
+            os << " " << core::core_segment::get(seg) << "+";
+            os << std::hex << cols().address[row] << std::dec;
         }
         
-        auto& p = dl_reader();
-        auto  n = cnt;
-        while (n--)
-        {
-            os << " ";
-            os << dl_state_names::value[*p++];
-            os << "=" << std::to_string(*p++);
-        }
+        do_apply([&os](auto key, auto value)
+            {
+                os << " ";
+                os << dl_state_names::value[key];
+                os << "=" << std::to_string(value);
+            });
     }
 
-    // clear local static for next run of test fixture:b
+    // clear local static for next run of test fixture
+    // NB: release memory
     static void clear()
     {
-        file_num = {};
+        cols() = {};
     }
+
 private:
-    dl_value_t dl_line_num;
-    uint32_t   dl_address {};      // XXX should be 32-bit/64-bit based on address
-    uint8_t    dl_segment {};      // XXX should be ref::index_t
-    uint8_t    cnt        {};
-    static inline dl_value_t file_num;
-    
-    static inline core::kas_clear _c{base_t::obj_clear};
+    index_t row;
+    static inline core::kas_clear _c{clear};
 };
 
-
 }
 
 #endif
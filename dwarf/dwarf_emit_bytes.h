@@ -0,0 +1,150 @@
+#ifndef KAS_DWARF_DWARF_EMIT_BYTES_H
+#define KAS_DWARF_DWARF_EMIT_BYTES_H
+
+// Generate DWARF data directly as a byte stream
+//
+// `dwarf::emit_insn` packages each DWARF value as `fixed` data insn
+// arguments. For the `.debug_line` program, this creates several insns
+// per row, each of which is relaxed & emitted individually.
+//
+// `.debug_line` is generated after the code sections are relaxed &
+// emitted, so row addresses are constants. `dwarf::emit_bytes` accepts
+// the same calls as `emit_insn`, but formats single byte & LEB values
+// directly into a byte buffer. The buffer is inserted as `opc_dw_bytes`
+// insns, each of which is a fixed size, single chunk of data.
+//
+// Values which require target conversion (multi-byte values, expressions
+// such as the `DW_LNE_set_address` relocation) & labels are forwarded
+// to the `emit_insn` base after pending bytes are flushed.
+
+#include "dwarf_emit.h"
+#include "expr/expr_leb.h"
+#include "kas_core/kas_clear.h"
+
+#include <deque>
+#include <string>
+
+namespace kas::core::opc
+{
+    // single chunk of bytes generated by `dwarf::emit_bytes`
+    struct opc_dw_bytes : opcode
+    {
+        OPC_INDEX();
+        const char *name() const override { return "DW_BYTES"; }
+
+        // largest chunk held in single insn
+        static constexpr std::size_t max_chunk = 1 << 15;
+
+        // store chunk: return index
+        static unsigned add(std::string&& bytes)
+        {
+            chunks().push_back(std::move(bytes));
+            return chunks().size();
+        }
+
+        void operator()(data_t& data, unsigned index) const
+        {
+            data.fixed.fixed = index;
+            data.size        = chunks()[index - 1].size();
+        }
+
+        void fmt(data_t const& data, std::ostream& os) const override
+        {
+            os << data.fixed.fixed << ", " << data.size();
+        }
+
+        void emit(data_t const& data, core_emit& base, core_expr_dot const *dot_p) const override
+        {
+            auto& bytes = chunks()[data.fixed.fixed - 1];
+            base << emit_data(sizeof(char), data.size()) << bytes.data();
+        }
+
+    private:
+        static std::deque<std::string>& chunks()
+        {
+            static std::deque<std::string> chunks_;
+            return chunks_;
+        }
+
+        static void clear()
+        {
+            chunks().clear();
+        }
+
+        static inline kas_clear _c{clear};
+    };
+}
+
+namespace kas::dwarf
+{
+
+struct emit_bytes
+{
+    emit_bytes(emit_insn& base) : base(base) {}
+
+    // destructor: emit pending bytes
+    ~emit_bytes() { flush(); }
+
+    // emit dwarf "named" value
+    template <typename DEFN, typename Arg
+            , typename OP = typename std::remove_reference_t<DEFN>::op>
+    void operator()(DEFN&& d, Arg&& arg)
+    {
+        using defn_t = std::remove_cv_t<std::remove_reference_t<DEFN>>;
+        using arg_t  = std::remove_cv_t<std::remove_reference_t<Arg>>;
+
+        auto fn = [this](uint8_t c) { put(c); };
+
+        if constexpr (std::is_integral_v<arg_t> && std::is_same_v<defn_t, UBYTE>)
+            put(arg);
+        else if constexpr (std::is_integral_v<arg_t> && std::is_same_v<defn_t, ULEB>)
+            expression::uleb128<uint32_t>::write(fn, arg);
+        else if constexpr (std::is_integral_v<arg_t> && std::is_same_v<defn_t, SLEB>)
+            expression::sleb128<int32_t>::write(fn, arg);
+        else
+        {
+            // requires target conversion
+            flush();
+            base(std::forward<DEFN>(d), std::forward<Arg>(arg));
+        }
+    }
+
+    // forward other ops (eg: labels) & dot references
+    template <typename...Ts>
+    void operator()(Ts&&...args)
+    {
+        flush();
+        base(std::forward<Ts>(args)...);
+    }
+
+    auto& get_dot(int which = core::core_addr_t::DOT_CUR)
+    {
+        flush();
+        return base.get_dot(which);
+    }
+
+private:
+    void put(uint8_t c)
+    {
+        bytes.push_back(c);
+        if (bytes.size() >= core::opc::opc_dw_bytes::max_chunk)
+            flush();
+    }
+
+    // emit pending bytes as single insn
+    void flush()
+    {
+        if (bytes.empty())
+            return;
+        auto index = core::opc::opc_dw_bytes::add(std::move(bytes));
+        bytes = {};
+        base(core::opc::opc_dw_bytes(), index);
+    }
+
+    emit_insn&   base;
+    std::string  bytes;
+};
+
+}
+
+#endif
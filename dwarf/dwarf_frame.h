@@ -5,14 +5,65 @@
 #include "dwarf_opc.h"
 #include "dwarf_frame_data.h"
 #include "dwarf_emit.h"
+#include "expr/expr_leb.h"
 #include <meta/meta.hpp>
 
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
 namespace kas::dwarf
 {
 using namespace meta;
 
+// `.eh_frame` pointer encodings (LSB: Exception Frames)
+enum dw_eh_pe : uint8_t
+{
+      DW_EH_PE_absptr  = 0x00
+    , DW_EH_PE_udata4  = 0x03
+    , DW_EH_PE_sdata4  = 0x0b
+    , DW_EH_PE_pcrel   = 0x10
+    , DW_EH_PE_datarel = 0x30
+    , DW_EH_PE_omit    = 0xff
+};
+
+// `.eh_frame` FDE address encoding
+static constexpr auto K_EH_FDE_ENCODING = DW_EH_PE_pcrel | DW_EH_PE_sdata4;
+
+// XXX ARM: CIE alignment factors
+static constexpr auto K_CFA_CODE_ALIGN = 2;
+static constexpr auto K_CFA_DATA_ALIGN = -4;
+
+// collect CFI instructions as bytes: CIE initial instructions
+// NB: accepts formats used by `emit_cfi`
+struct cfi_bytes
+{
+    template <typename DEFN, typename Arg>
+    void operator()(DEFN, Arg value)
+    {
+        auto fn = [this](uint8_t c) { bytes.push_back(c); };
+        if constexpr (std::is_same_v<DEFN, ULEB>)
+            expression::uleb128<uint32_t>::write(fn, value);
+        else if constexpr (std::is_same_v<DEFN, SLEB>)
+            expression::sleb128<int32_t>::write(fn, value);
+        else
+            bytes.push_back(value);
+    }
+
+    void operator()(TEXT, const char *text)
+    {
+        bytes.append(text);
+        bytes.push_back(0);
+    }
+
+    std::string bytes;
+};
+
+// NB: `.eh_frame` is a variant of `.debug_frame`: CIE id, version,
+// augmentation & pointer formats differ
 template <typename T>
-auto& emit_frame_cie(T& emit)
+auto& emit_frame_cie(T& emit, std::string const& insns, bool eh_frame = false)
 {
     using core::core_symbol_t;
     using core::core_addr_t;
@@ -27,18 +78,32 @@ auto& emit_frame_cie(T& emit)
     
     // section length (not including section length field)
     emit(UWORD(), end_cie - bgn_cie - UWORD::size);
-    emit(UWORD(), -1);                      // CIE_id (0xffff'ffff -> CIE)
-    emit(UBYTE(), 4);                       // CIE version #
-    emit(TEXT(), "");                       // (no) augmentation
+    if (eh_frame)
+    {
+        emit(UWORD(), 0);                   // CIE_id (zero -> CIE)
+        emit(UBYTE(), 1);                   // CIE version #
+        emit(TEXT(), "zR");                 // augmentation: FDE encoding
+    }
+    else
+    {
+        emit(UWORD(), -1);                  // CIE_id (0xffff'ffff -> CIE)
+        emit(UBYTE(), 4);                   // CIE version #
+        emit(TEXT(), "");                   // (no) augmentation
 
-    emit(UBYTE(), sizeof(dl_addr_t));       // sizeof address
-    emit(UBYTE(), 0);                       // segment selector
+        emit(UBYTE(), sizeof(dl_addr_t));   // sizeof address
+        emit(UBYTE(), 0);                   // segment selector
+    }
 
-    //emit(ULEB(), sizeof(dl_addr_t));        // code alignment factor
-    emit(ULEB(),  2);                       // XXX ARM
-    emit(SLEB(), -4);                       // XXX ARM data alignment factor
+    emit(ULEB(), K_CFA_CODE_ALIGN);         // code alignment factor
+    emit(SLEB(), K_CFA_DATA_ALIGN);         // data alignment factor
     emit(ULEB(), 14);                       // XXX ARM return address column
 
+    if (eh_frame)
+    {
+        emit(ULEB(), 1);                    // augmentation data length
+        emit(UBYTE(), K_EH_FDE_ENCODING);   // `R`: FDE pointer encoding
+    }
+
     //emit(UBYTE(), ...initial insns...);
     // XXX m68k uint32_t cmds[] = {0x0c, 0x0f, 0x04, 0x98, 0x01};
     // XXX ARM
@@ -46,19 +111,23 @@ auto& emit_frame_cie(T& emit)
     for (auto&& cmd : cmds)
         emit(UBYTE(), cmd);
     
+    // initial instructions shared by frames
+    for (uint8_t c : insns)
+        emit(UBYTE(), c);
+
     emit(opc_align(), sizeof(dl_addr_t));   // pad to multiple of addr_size
     emit(end_cie);                          // define address `end_cie`
     return bgn_cie;                         // used by `FDE`
 }
 
 // implement ADVANCE_LOC
+// NB: frames are generated after code is relaxed: select smallest insn
 template <typename T>
 void advance_loc(T& emit, unsigned& loc, unsigned new_loc)
 {
     int32_t delta = new_loc - loc;
     loc = new_loc;          // update address
-    delta /= 2;             // XXX code alignment factor
-
+    delta /= K_CFA_CODE_ALIGN;
 
     // generate appropriate insn based on `delta`
     if (delta == 0)
@@ -90,12 +159,64 @@ void advance_loc(T& emit, unsigned& loc, unsigned new_loc)
         emit(UBYTE(), code);
         emit(UWORD(), delta);
     }
-    loc = new_loc;
 }
 
-// emit frame
+// emit CFI insn `d`. Read args using `fn`
+template <typename T, typename READ_FN>
+void emit_cfi(T& emit, READ_FN& fn, dw_frame_data const& d)
+{
+    auto& cmd = DWARF_CMDS::value[d.cmd];
+    
+    // emit CFI insn
+    // if > 0x80, emit with first data value
+    auto code = cmd.code;
+    if (code < 0x80)
+        emit(ULEB(), code);
+
+    // emit args
+    auto n = cmd.arg_c;
+    for (auto p = cmd.args; n--; ++p)
+    {
+        // NB: no cmd with "TEXT" arg has code < 0x80
+        if (!strcmp(*p, "TEXT"))
+        {
+            std::string text{};
+            while (auto c = fn())
+                text += c;
+            emit(TEXT(), text.c_str());
+        }
+        else if (!strcmp(*p, "BLOCK"))
+        {
+            // NB: no cmd with "BLOCK" arg has code < 0x80
+            // expression??
+        }
+        else 
+        {
+            // integral value
+            auto v = dw_frame_data::leb128::read(fn);
+            if (code >= 0x80)
+            {
+                emit(UBYTE(), code + v);
+                code = 0;
+            }
+            else if (**p == 'F')
+            {
+                // scaled & factored
+                emit(SLEB(), (int32_t)v / K_CFA_DATA_ALIGN);
+            }
+            else if (**p == 'S')
+                emit(SLEB(), v);
+            else
+                emit(ULEB(), v);
+        }
+    }
+}
+
+// emit frame. Return FDE address
+// NB: first `lead` CFI insns are CIE initial instructions: not emitted
 template <typename T, typename FRAME_INFO>
-void emit_dwarf_frame(T& emit, core::core_addr_t const& cie, FRAME_INFO const& f)
+auto& emit_dwarf_frame(T& emit, core::core_addr_t const& cie, FRAME_INFO const& f
+                     , unsigned lead, bool eh_frame = false)
 {
     using core::core_symbol_t;
     using core::core_addr_t;
@@ -107,85 +228,99 @@ void emit_dwarf_frame(T& emit, core::core_addr_t const& cie, FRAME_INFO const& f
     auto& end_fde  = core_addr_t::add();    // allocate unresolved address
 
     auto& start_proc = dw_frame_data::get(f.start);
-    auto& end_proc   = dw_frame_data::get(f.start + f.delta);
 
     // section length (not including section length field)
     emit(UWORD(), end_fde - bgn_fde - UWORD::size);
-    emit(ADDR(),  cie);
-    emit(ADDR(),  f.begin_addr());
-    emit(UWORD(), f.end_addr() - f.begin_addr());
-
+    if (eh_frame)
+    {
+        // CIE pointer: offset from field. FDE pointers: `K_EH_FDE_ENCODING`
+        emit(UWORD(), emit.get_dot() - cie);
+        emit(UWORD(), f.begin_addr() - emit.get_dot());
+        emit(UWORD(), f.end_addr() - f.begin_addr());
+        emit(ULEB(),  0);                   // augmentation data length
+    }
+    else
+    {
+        emit(ADDR(),  cie);
+        emit(ADDR(),  f.begin_addr());
+        emit(UWORD(), f.end_addr() - f.begin_addr());
+    }
 
     auto fn = [&reader = dw_frame_data::df_reader()]()
     {
         return *reader++;
     };
     unsigned offset = start_proc.offset()();
-    auto emit_cfi = [&emit, &offset, &fn](dw_frame_data const& d)
+    auto emit_fde_cfi = [&](dw_frame_data const& d)
     {
-        auto& cmd = DWARF_CMDS::value[d.cmd];
+        // skip CIE instructions (but consume args)
+        if (lead)
+        {
+            --lead;
+            cfi_bytes skip;
+            return emit_cfi(skip, fn, d);
+        }
         
         // advance PC as required
         if (offset < d.offset()())
             advance_loc(emit, offset, d.offset()());
 
-        // emit CFI insn
-        // if > 0x80, emit with first data value
-        auto code = cmd.code;
-        if (code < 0x80)
-            emit(ULEB(), code);
-
-        // emit args
-        auto n = cmd.arg_c;
-        for (auto p = cmd.args; n--; ++p)
-        {
-            // NB: no cmd with "TEXT" arg has code < 0x80
-            if (!strcmp(*p, "TEXT"))
-            {
-                std::string text{};
-                while (auto c = fn())
-                    text += c;
-                emit(TEXT(), text.c_str());
-            }
-            else if (!strcmp(*p, "BLOCK"))
-            {
-                // NB: no cmd with "BLOCK" arg has code < 0x80
-                // expression??
-            }
-            else 
-            {
-                // integral value
-                auto v = dw_frame_data::leb128::read(fn);
-                if (code >= 0x80)
-                {
-                    emit(UBYTE(), code + v);
-                    code = 0;
-                }
-                else if (**p == 'F')
-                {
-                    // scaled & factored
-                    emit(SLEB(), -v >> 2);
-                }
-                else if (**p == 'S')
-                    emit(SLEB(), v);
-                else
-                    emit(ULEB(), v);
-            }
-
-        }
+        emit_cfi(emit, fn, d);
     };
 
     // don't emit `startproc` nor `endproc` cmds
     // NB: `startproc` and `endproc` don't have args
-    dw_frame_data::for_each(emit_cfi, f.start + 1, f.delta - 1);
+    dw_frame_data::for_each(emit_fde_cfi, f.start + 1, f.delta - 1);
 
     emit(opc_align(), 4);                     // pad to multiple of addr_size
     emit(end_fde);                            // define address `end_fde`
+    return bgn_fde;
+}
+
+// CFI insns at start of frame (before any `advance_loc`) are moved to the
+// CIE. Frames with same initial instructions share CIE.
+// return initial instructions as bytes & count of CFI insns
+template <typename FRAME_INFO>
+auto frame_cie_insns(FRAME_INFO const& f)
+{
+    auto fn = [&reader = dw_frame_data::df_reader()]()
+    {
+        return *reader++;
+    };
+
+    cfi_bytes insns, skip;
+    unsigned  lead  {};
+    bool      done  {};
+    auto      start = dw_frame_data::get(f.start).offset()();
+
+    dw_frame_data::for_each([&](dw_frame_data const& d)
+        {
+            if (!done && d.offset()() == start)
+            {
+                ++lead;
+                emit_cfi(insns, fn, d);
+            }
+            else
+            {
+                done = true;
+                emit_cfi(skip, fn, d);
+            }
+        }, f.start + 1, f.delta - 1);
+
+    return std::make_pair(std::move(insns.bytes), lead);
 }
 
+// `.eh_frame` address for `.eh_frame_hdr`
+struct eh_frame_hdr
+{
+    static inline core::core_addr_t const *eh_frame_p;
+
+    static void clear() { eh_frame_p = {}; }
+    static inline core::kas_clear _c{clear};
+};
 
 template <typename Inserter>
-void dwarf_frame_gen(Inserter&& inserter)
+void dwarf_frame_gen(Inserter&& inserter, bool eh_frame = false)
 {
     //std::cout << __FUNCTION__ << std::endl;
     //dw_frame_data::dump(std::cout);
@@ -193,14 +328,117 @@ void dwarf_frame_gen(Inserter&& inserter)
     // construct emitter
     emit_insn emit(inserter);
 
-    // generate CIE header. Return "CIE" address used by "FDE"
-    auto& cie = emit_frame_cie(emit);
+    // find initial instructions for each frame
+    auto& frames = dw_frame_data::frames();
+    std::vector<std::pair<std::string, unsigned>> frame_insns;
+    
+    dw_frame_data::df_reader(true);     // reset reader
+    for (auto& frame : frames)
+        frame_insns.push_back(frame_cie_insns(frame));
+
+    // generate CIEs. Map initial instructions to "CIE" address used by "FDE"
+    // NB: CIEs precede FDEs: `.eh_frame` CIE pointer is backwards offset
+    std::map<std::string, core::core_addr_t const *> cies;
+    for (auto& [insns, lead] : frame_insns)
+    {
+        auto& cie_p = cies[insns];
+        if (!cie_p)
+            cie_p = &emit_frame_cie(emit, insns, eh_frame);
+        if (eh_frame && !eh_frame_hdr::eh_frame_p)
+            eh_frame_hdr::eh_frame_p = cie_p;
+    }
 
     // for each frame, emit FDE header, prologue, and commands
     dw_frame_data::df_reader(true);     // reset reader
+    auto p = frame_insns.begin();
+    for (auto& frame : frames)
+    {
+        auto& [insns, lead] = *p++;
+        auto& fde = emit_dwarf_frame(emit, *cies[insns], frame, lead, eh_frame);
+        if (eh_frame)
+            frame.fde_p = &fde;
+    }
+}
+
+// generate `.eh_frame_hdr`: `.eh_frame` pointer & binary search table
+// NB: `.eh_frame` must be emitted first: table holds FDE addresses
+//
+// The assembler writes only relocatable objects, so the header is not
+// final: `.eh_frame` pointer & table entries are relocated PC-relative
+// values. The header is valid only if the object is the sole input
+// providing `.eh_frame` & `.eh_frame_hdr` & the linker neither rewrites
+// `.eh_frame` nor generates its own header (ie: no `ld --eh-frame-hdr`).
+//
+// Table order must not depend on link layout, so all frames must be in
+// one section (& subsection). Otherwise an error is reported for the
+// first frame elsewhere & the table is omitted.
+template <typename Inserter>
+void dwarf_frame_hdr_gen(Inserter&& inserter)
+{
+    using frame_info = dw_frame_data::frame_info;
+    
+    emit_insn emit(inserter);
+
+    // sort frames by initial location
+    std::vector<frame_info const *> table;
     for (auto& frame : dw_frame_data::frames())
+        if (frame.fde_p)
+            table.push_back(&frame);
+    
+    auto key = [](frame_info const *f)
+        {
+            auto& d = dw_frame_data::get(f->start);
+            return std::make_pair(d.segment().index(), d.offset()());
+        };
+    std::stable_sort(table.begin(), table.end(), [&key](auto a, auto b)
+        {
+            return key(a) < key(b);
+        });
+
+    // order of frames in different sections is decided by linker
+    auto single_segment = [&table]
+        {
+            auto& first = dw_frame_data::get(table.front()->start).segment();
+            for (auto f : table)
+                if (&dw_frame_data::get(f->start).segment() != &first)
+                {
+                    parser::kas_diag_t::error(
+                            ".eh_frame_hdr requires all frames in one section", f->loc);
+                    return false;
+                }
+            return true;
+        };
+
+    auto& bgn_hdr = emit.get_dot();
+    int  table_enc = DW_EH_PE_omit;
+    if (eh_frame_hdr::eh_frame_p && (table.empty() || single_segment()))
+        table_enc = DW_EH_PE_datarel | DW_EH_PE_sdata4;
+
+    emit(UBYTE(), 1);                               // version
+    emit(UBYTE(), DW_EH_PE_pcrel | DW_EH_PE_sdata4);// eh_frame_ptr encoding
+    emit(UBYTE(), DW_EH_PE_udata4);                 // fde_count encoding
+    emit(UBYTE(), table_enc);                       // table encoding
+
+    if (!eh_frame_hdr::eh_frame_p)
+    {
+        // no `.eh_frame`: no table
+        emit(UWORD(), 0);
+        return;
+    }
+
+    emit(UWORD(), *eh_frame_hdr::eh_frame_p - emit.get_dot());
+    if (table_enc == DW_EH_PE_omit)
+    {
+        emit(UWORD(), 0);
+        return;
+    }
+    emit(UWORD(), (int)table.size());
+
+    // (initial location, FDE address) pairs: relative to `.eh_frame_hdr`
+    for (auto f : table)
     {
-        emit_dwarf_frame(emit, cie, frame);    
+        emit(UWORD(), f->begin_addr() - bgn_hdr);
+        emit(UWORD(), *f->fde_p       - bgn_hdr);
     }
 }
 }
@@ -114,6 +114,12 @@ struct dw_frame_data : core::kas_object<dw_frame_data>
         uint32_t start {};
         uint32_t delta    : 28;
         uint32_t prologue : 4;
+
+        // FDE address: set when frame emitted
+        core::core_addr_t const *fde_p {};
+
+        // `startproc` location (for diagnostics)
+        parser::kas_loc loc {};
     };
 
 private:
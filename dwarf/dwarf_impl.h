@@ -12,9 +12,13 @@
 #include "dwarf_fsm.h"
 #include "dwarf_opc.h"
 #include "dwarf_emit.h"
+#include "dwarf_emit_bytes.h"
+#include "kas_core/core_options.h"
 
 #include <meta/meta.hpp>
 
+#include <map>
+
 namespace kas::dwarf
 {
 using namespace meta;
@@ -85,8 +89,8 @@ auto& gen_dwarf_32_header(T& emit)
     emit(UBYTE(), K_LNS_MIN_INSN_LENGTH);
     emit(UBYTE(), K_LNS_MAX_OPS_PER_INSN);  // added version 4
     emit(UBYTE(), K_LNS_DEFAULT_IS_STMT);
-    emit(UBYTE(), K_LNS_LINE_BASE);
-    emit(UBYTE(), K_LNS_LINE_RANGE);
+    emit(UBYTE(), dl_special::line_base);
+    emit(UBYTE(), dl_special::line_range);
     emit(UBYTE(), K_LNS_OPCODE_BASE);
     
     // emit # of operands for std opcodes
@@ -291,8 +295,8 @@ void emit_rule(DL_STATE& s, EMIT& emit, Ts...args)
     {
         auto pc_delta   = std::get<0>(std::forward_as_tuple(args...));
         auto line_delta = std::get<1>(std::forward_as_tuple(args...));
-             code       = pc_delta * K_LNS_LINE_RANGE;
-             code      += line_delta - K_LNS_LINE_BASE;
+             code       = pc_delta * dl_special::line_range;
+             code      += line_delta - dl_special::line_base;
 
         emit(UBYTE(), (int)code + K_LNS_OPCODE_BASE);
     }
@@ -437,8 +441,10 @@ bool gen_pgm(dl_data& d, DL_STATE& s, EMIT& emit)
 
     // check if line_delta is out-of-range of the "special" opcode
     // if so, emit "advance line" rule & clear delta
-    if (line_delta <   K_LNS_LINE_BASE ||
-        line_delta >= (K_LNS_LINE_BASE + K_LNS_LINE_RANGE)) {
+    auto line_base = dl_special::line_base;
+    auto op_range  = dl_special::op_range();
+    if (line_delta <   line_base ||
+        line_delta >= (line_base + dl_special::line_range)) {
 
         // out-of-range. Emit advance-line opcode
         emit_rule(s, emit, DL_line, line_delta);
@@ -448,7 +454,7 @@ bool gen_pgm(dl_data& d, DL_STATE& s, EMIT& emit)
     // NB: op_advance_delta can't be < 0
     // XXX worst case for when max line_delta won't fit with max op_advance
     // XXX for now, just limit to 2*MAX-1
-    if (op_advance_delta > (K_LNS_OP_RANGE * 2 - 1)) {
+    if (op_advance_delta > (op_range * 2 - 1)) {
         emit_rule(s, emit, DL_address, op_advance_delta);
         op_advance_delta = 0;
     }
@@ -456,9 +462,10 @@ bool gen_pgm(dl_data& d, DL_STATE& s, EMIT& emit)
     if (line_delta == 0 && op_advance_delta == 0) {
         emit_rule<RULE_copy>(s, emit);
     } else {
-        if (op_advance_delta > K_LNS_OP_RANGE) {
+        // NB: special opcode for `op_range` may exceed 255
+        if (op_advance_delta >= op_range) {
             emit_rule<RULE_const_add_pc>(s, emit);
-            op_advance_delta -= K_LNS_OP_RANGE;
+            op_advance_delta -= op_range;
         }
         emit_rule<RULE_special>(s, emit, op_advance_delta, line_delta);
     }
@@ -469,6 +476,97 @@ bool gen_pgm(dl_data& d, DL_STATE& s, EMIT& emit)
 #endif
 
 
+// choose `line_base` & `line_range` to minimize size of line program
+// histogram (line delta, op advance) pairs as generated by `gen_pgm`
+// & estimate program size for each set of parameters.
+inline void tune_special_opcodes()
+{
+    std::map<std::pair<int, int>, unsigned> hist;
+    DL_STATE s;
+
+    dl_data::for_each([&](auto& d)
+        {
+            auto old_line_num = s.state[DL_line];
+            bool end_seq      = false;
+            int  line_delta   = 0;
+    
+            if (auto n = d.line_num())
+                line_delta = n - old_line_num;
+
+            d.do_apply([&](auto key, auto value)
+                {
+                    if (key == DL_line && value != old_line_num)
+                        line_delta = value - old_line_num;
+                    else if (key == DL_end_sequence && value)
+                        end_seq = true;
+                });
+            
+            if (d.segment() != s.state[DL_address])
+            {
+                s.state[DL_address] = d.segment();
+                s.address           = d.address();
+            }
+
+            if (end_seq)
+            {
+                s.init();
+                return;
+            }
+            
+            ++hist[{ line_delta, op_advance(d.address() - s.address) }];
+            s.state[DL_line] += line_delta;
+            s.address         = d.address();
+        });
+
+    // NB: signed LEB size. may overstate unsigned size by one
+    auto leb_size = [](int value)
+        {
+            unsigned n = 1;
+            while (value > 63 || value < -64)
+            {
+                value >>= 7;
+                ++n;
+            }
+            return n;
+        };
+
+    // estimate program size: see `gen_pgm`
+    auto pgm_size = [&](int base, int range)
+        {
+            auto op_range = dl_special::op_range(range);
+            std::size_t size = 0;
+            for (auto& [delta, count] : hist)
+            {
+                auto [line_delta, op_adv] = delta;
+                unsigned n = 1;             // special or copy
+                if (line_delta < base || line_delta >= base + range)
+                    n += 1 + leb_size(line_delta);
+                if (op_adv > op_range * 2 - 1)
+                    n += 1 + leb_size(op_adv);
+                else if (op_adv >= op_range)
+                    ++n;                    // const_add_pc
+                size += n * count;
+            }
+            return size;
+        };
+
+    // NB: zero line delta must be special after DW_LNS_advance_line
+    auto best_base  = K_LNS_LINE_BASE;
+    auto best_range = K_LNS_LINE_RANGE;
+    auto best_size  = pgm_size(best_base, best_range);
+    for (int range = 1; range <= 64; ++range)
+        for (int base = 1 - range; base <= 0; ++base)
+            if (auto size = pgm_size(base, range); size < best_size)
+            {
+                best_base  = base;
+                best_range = range;
+                best_size  = size;
+            }
+
+    dl_special::line_base  = best_base;
+    dl_special::line_range = best_range;
+}
+
 template <typename Inserter>
 void dwarf_gen(Inserter&& inserter)
 {
@@ -477,17 +575,34 @@ void dwarf_gen(Inserter&& inserter)
     emit_insn emit{inserter};
     DL_STATE state;
 
+    // select special opcode parameters before header emitted
+    if (core::dwarf_options::line_tune)
+        tune_special_opcodes();
+    else
+        dl_special::set_default();
+
     // generate header. Return "end" symbol to be defined after data emited
     auto& end= gen_dwarf_32_header(emit);
     
     // iterate thru dwarf_line data instructions to generate FSM program
-    auto gen_line = [&state, &emit](auto& d)
+    auto gen_lines = [&state](auto& emit)
         {
-            auto do_init = gen_pgm(d, state, emit);
-            if (do_init)
-                state.init();
+            dl_data::for_each([&](auto& d)
+                {
+                    auto do_init = gen_pgm(d, state, emit);
+                    if (do_init)
+                        state.init();
+                });
         };
-    dl_data::for_each(gen_line);
+
+    // row addresses are final: optionally generate program as bytes
+    if (core::dwarf_options::line_direct)
+    {
+        emit_bytes bytes{emit};
+        gen_lines(bytes);
+    }
+    else
+        gen_lines(emit);
 
     // now emit end label.
     emit(end);
@@ -559,7 +674,7 @@ struct OP_ADD_PC
     
     template <typename EMIT, typename...FMTS>
     void operator()(DL_STATE& s, EMIT& emit, unsigned col, meta::list<FMTS...>
-                                    ,dl_value_t op_adv_delta = K_LNS_OP_RANGE, dl_value_t line_delta = 0) 
+                                    ,dl_value_t op_adv_delta = dl_special::op_range(), dl_value_t line_delta = 0) 
     {
 #if 0
         // XXX simplify for no op_index
@@ -56,6 +56,27 @@ static constexpr auto K_LNS_DEFAULT_IS_STMT = 1;
 static constexpr auto K_LNS_MIN_INSN_LENGTH = 2;
 static constexpr auto K_LNS_MAX_OPS_PER_INSN = 1;
 
+// special opcode parameters: `K_LNS_*` defaults or tuned to line data
+// (see `tune_special_opcodes()`)
+struct dl_special
+{
+    static inline int line_base  = K_LNS_LINE_BASE;
+    static inline int line_range = K_LNS_LINE_RANGE;
+
+    // `op_advance` of DW_LNS_const_add_pc
+    // NB: `op_advance` less than `op_range` is always a valid special opcode
+    static int op_range(int range = line_range)
+    {
+        return (255 - K_LNS_OPCODE_BASE) / range;
+    }
+
+    static void set_default()
+    {
+        line_base  = K_LNS_LINE_BASE;
+        line_range = K_LNS_LINE_RANGE;
+    }
+};
+
 
 struct DL_STATE
 {
@@ -7,6 +7,8 @@
 #include "parser/parser_obj.h"
 
 #include "core_symbol.h"        // for dump
+#include "core_stats.h"
+#include "core_trace.h"
 
 namespace kas::core
 {
@@ -35,9 +37,15 @@ struct kas_assemble
         
         // NB: `at_end` is method to perform after all insns consumed
         auto& obj = INSNS::add(text_seg, at_end);
-        assemble_src(obj.inserter(), src, out);
+        {
+            // NB: `resolve_symbols` runs (and is timed) in inserter dtor
+            core_stats::timer t("parse");
+            core_trace::span  s("assemble_src", "parse");
+            assemble_src(obj.inserter(), src, out);
+        }
 
         std::cout << "parse complete" << std::endl;
+        core_stats::count(core_stats::CNT_INSTRUCTIONS, obj.insns.size());
 
 //#define DUMP_AFTER_PARSE
 #ifdef DUMP_AFTER_PARSE
@@ -70,6 +78,11 @@ struct kas_assemble
         // 3. relax object code
         do_relax(obj, out);
         std::cout << "relax complete" << std::endl;
+
+        // record object counts for `--statistics`
+        core_stats::count(core_stats::CNT_FRAGMENTS  , core_fragment::num_objects());
+        core_stats::count(core_stats::CNT_SYMBOLS    , core_symbol_t::num_objects());
+        core_stats::count(core_stats::CNT_EXPRESSIONS, core_expr_t::num_objects());
         
         kas::parser::kas_diag_t::dump(std::cout);
         
@@ -88,8 +101,11 @@ struct kas_assemble
         kas::core::core_symbol_t::dump(std::cout);
     }
 
-    void emit(emit_stream_base& e)
+    // NB: `phase` names timer (eg: separate object & listing emits)
+    void emit(emit_stream_base& e, const char *phase = "emit")
     {
+        core_stats::timer t(phase);
+
         // 1. rewind to initial section (normally ".text")
         e.set_segment(core_section::get_initial());
        
@@ -100,8 +116,13 @@ struct kas_assemble
                 if (auto& p = container.deferred_ops_p)
                 {
                     // generate data & relax container
-                    p->gen_data(container.inserter());
+                    core_stats::timer t("deferred");
+                    {
+                        core_trace::span s("gen_data", "deferred");
+                        p->gen_data(container.inserter());
+                    }
                     do_relax(container, &std::cout);
+                    core_stats::count(core_stats::CNT_DEFERRED, container.insns.size());
                     p = {};     // don't generate again
                 }
                 
@@ -131,6 +152,7 @@ private:
         // `stmt_stream` checks syntax, not semantics
         for (auto&& stmt : stmt_stream)
         {
+            core_stats::count(core_stats::CNT_STATEMENTS);
             if (out)
             {
                 *out << "in :  " << stmt.src() << std::endl;
@@ -174,6 +196,7 @@ private:
             // 1. error undefined "internal" symbols.
             // 2. mark undefined "referenced" symbols as GLOBL
             // 3. move lcomm symbols to bss
+            core_stats::timer t("resolve_symbols");
             auto resolve_one_symbol = [&inserter, seg_index=seg.index()](auto& sym) mutable
             {
                 // 1. error undefined internal symbols
@@ -6,6 +6,7 @@
 
 #include "expr/expr.h"
 #include "emit_stream.h"
+#include "kbfd/kbfd_endian.h"
 #include "core_reloc.h"
 #include "core_fragment.h"
 #include "core_symbol.h"
@@ -24,6 +25,7 @@ struct set_size;
 struct emit_reloc;
 struct emit_disp;
 struct emit_data;
+struct emit_filler;
 
 struct core_emit
 {
@@ -113,6 +115,7 @@ private:
     friend emit_reloc;
     friend emit_disp;
     friend emit_data;
+    friend emit_filler;
 
     // set width & emit object code
     void put_fixed(int64_t value, uint8_t obj_width = {});
@@ -341,27 +344,62 @@ private:
 };
 
 // filler data manipulator: usage example: .fill & .align
-// NB: not a `core_emit` friend. Use `emit_data` interface
+// emit `count` copies of `fill_w` byte value `fill_c`
 struct emit_filler
 {
     using emit_value_t = typename core_emit::emit_value_t;
     
-    emit_filler(uint8_t n, emit_value_t fill_c = 0, uint8_t fill_w = sizeof(char))
-        : num_bytes(n), fill_c(fill_c), fill_w(fill_w) {}
+    emit_filler(unsigned count, emit_value_t fill_c = 0, uint8_t fill_w = sizeof(char))
+        : count(count), fill_c(fill_c), fill_w(fill_w) {}
 
 private:
+    // g++ requires trampoline for `friend` to work
+    // NB: as GNU `as`, widths other than 1, 2, 4 emit (up to) four bytes
+    // of `fill_c` in target byte order, followed by zeros
+    void put_fill(core_emit& b) const
+    {
+        switch (fill_w)
+        {
+            case 1:
+            case 2:
+            case 4:
+                b.stream.put_fill(b.e_chan, fill_w, fill_c, count);
+                break;
+            case 3:
+            {
+                auto lsb_first = b.obj_p && b.obj_p->swap.target == std::endian::little;
+                auto msb = (fill_c >> 16) & 0xff;
+                auto lsw = fill_c & 0xffff;
+                for (auto n = count; n--; )
+                {
+                    if (!lsb_first)
+                        b.stream.put_uint(b.e_chan, 1, msb);
+                    b.stream.put_uint(b.e_chan, 2, lsw);
+                    if (lsb_first)
+                        b.stream.put_uint(b.e_chan, 1, msb);
+                }
+                break;
+            }
+            default:
+                for (auto n = count; n--; )
+                {
+                    b.stream.put_uint(b.e_chan, 4, fill_c & 0xffff'ffff);
+                    b.stream.put_fill(b.e_chan, 1, 0, fill_w - 4);
+                }
+                break;
+        }
+        b.set_defaults();
+    }
+
     // don't return core_emit& because resetting operation to defaults
     friend void operator<<(core_emit& base, emit_filler const& s)
     {
-        // for now, just put N bytes of zero
-        static constexpr emit_value_t zero = 0;
-        base << emit_data(sizeof(char), s.num_bytes) << &zero;
+        s.put_fill(base);
     }
 
-    core_emit   *base_p;
+    unsigned     count;
     emit_value_t fill_c;
     uint8_t      fill_w;
-    uint8_t      num_bytes;
 };
 
 }
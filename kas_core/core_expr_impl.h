@@ -348,6 +348,66 @@ void core_expr<REF>::prune()
     minus.remove_if(empty);
 }
 
+// find sections in which locations are both added & subtracted
+// NB: follow symbol values (eg: `.set len, .Le - .Ls`)
+template <typename REF>
+auto core_expr<REF>::diff_sections() -> std::set<core_section const *>
+{
+    // sections of locations: [0] added, [1] subtracted
+    std::set<core_section const *> sections[2];
+
+    auto add_term = [&sections](auto& self, expr_term const& t
+                              , bool is_minus, int depth) -> void
+        {
+            auto addr_p  = t.addr_p;
+            auto value_p = t.value_p;
+            if (t.symbol_p && !addr_p && !value_p)
+            {
+                addr_p  = t.symbol_p->addr_p();
+                value_p = t.symbol_p->value_p();
+            }
+
+            if (addr_p && !addr_p->empty())
+                sections[is_minus].insert(&addr_p->section());
+
+            // max depth: big number to stop `.set` loops
+            if (!value_p || !depth--)
+                return;
+
+            if (auto p = value_p->get_p<symbol_ref>())
+                self(self, p->get(), is_minus, depth);
+            else if (auto p = value_p->get_p<addr_ref>())
+                self(self, p->get(), is_minus, depth);
+            else if (auto p = value_p->get_p<expr_ref>())
+            {
+                auto& e = p->get();
+                for (auto& t : e.plus)
+                    self(self, t, is_minus, depth);
+                for (auto& t : e.minus)
+                    self(self, t, !is_minus, depth);
+            }
+        };
+
+    std::set<core_section const *> result;
+    base_t::for_each([&](core_expr const& e)
+        {
+            // single term can't be difference. NB: `.set` values visited directly
+            if (e.plus.size() + e.minus.size() < 2)
+                return;
+
+            for (auto& s : sections)
+                s.clear();
+            for (auto& t : e.plus)
+                add_term(add_term, t, false, 100);
+            for (auto& t : e.minus)
+                add_term(add_term, t, true,  100);
+            for (auto s_p : sections[1])
+                if (sections[0].count(s_p))
+                    result.insert(s_p);
+        });
+    return result;
+}
+
 ///////////////////////////////////////////////////////////////////////////
 //
 // `expr_term` non-trivial constructors
@@ -32,6 +32,7 @@
 #include "parser/token_defn.h"
 #include "parser/kas_error.h"
 #include <list>
+#include <set>
 
 namespace kas::core
 {
@@ -163,6 +164,20 @@ public:
     // just declare because don't know "expression::e_fixed_t" yet.
     e_fixed_t const* get_fixed_p() const;
 
+    // if expression is `symbol + offset`, return symbol (& offset)
+    // NB: used to merge literal pool entries
+    core_symbol_t const *get_symbol_p(e_fixed_t& offset) const
+    {
+        if (!minus.empty() || plus.size() != 1)
+            return {};
+        offset = fixed;
+        return plus.front().symbol_p;
+    }
+
+    // sections in which an expression subtracts locations (eg: `.Le - .Ls`)
+    // NB: used to keep mergeable strings in place (see `opc_merge.h`)
+    static std::set<core_section const *> diff_sections();
+
 private:
     friend core_fits;
 
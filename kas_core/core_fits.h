@@ -18,6 +18,11 @@
 // This allows `core_fits` & `relax` fully resolve expressions
 // as `fuzz` is decreased.
 //
+// The optimistic `relax` strategy doesn't use `fuzz`. Instead displacements
+// are tested against the "minimum" layout (ie: offset.min) only. During
+// `GROW` passes, a displacement which fits the minimum layout is a
+// MIGHT_FIT. During the final `COMMIT` pass, it is a DOES_FIT.
+//
 // NB: access to current `dot` during relax is provided via `get_dot()` method
 
 #if 0
@@ -46,8 +51,11 @@ namespace kas::core
         using expr_fits::fits;
         using expr_fits::disp;
 
-        core_fits(core_expr_dot const *dot_p, int fuzz = {})
-            : dot_p(dot_p), fuzz(fuzz) {}
+        // `relax` strategy for `disp` tests (see above)
+        enum fits_mode_t : uint8_t { FUZZ, GROW, COMMIT };
+
+        core_fits(core_expr_dot const *dot_p, int fuzz = {}, fits_mode_t mode = FUZZ)
+            : dot_p(dot_p), fuzz(fuzz), mode(mode) {}
 
         
         // XXX legacy
@@ -208,7 +216,7 @@ namespace kas::core
                     return yes;
                 if (offset.max < disp)
                     return no;
-                return maybe;
+                return mode == COMMIT ? yes : maybe;
             }
 
             // validate against MIN (which can't decrese)
@@ -217,9 +225,17 @@ namespace kas::core
             if ((offset.min - disp) >= max)
                 return no;
 
-            // validate against MAX (applying fuzz)
+            // validate against MAX
             if ((offset.max - disp) < max)
                 return yes;
+
+            // optimistic relax: only "minimum" layout considered
+            if (mode == GROW)
+                return maybe;
+            if (mode == COMMIT)
+                return yes;
+
+            // validate against MAX (applying fuzz)
             if ((offset.max - disp) < (max+fuzz))
                 return maybe;
             return no;
@@ -229,6 +245,7 @@ namespace kas::core
         // pointer to real "dot"
         core_expr_dot const *dot_p;
         int fuzz;
+        fits_mode_t mode;
     };
 }
 
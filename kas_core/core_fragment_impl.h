@@ -47,6 +47,7 @@ The values incorporated are:
 #endif
 
 #include "core_fragment.h"
+#include "core_options.h"
 
 namespace kas::core
 {
@@ -244,8 +245,12 @@ void core_fragment::set_base(size_offset_t const& base)
         frag_base_addr.max += align_delta;
 
         // if base_address is stable, we can lock in alignment
+        // for optimistic relax, align `min` so it tracks the "minimum"
+        // layout (see `core_relax`)
         if (prev_is_relaxed)
             frag_base_addr.min += align_delta;
+        else if (relax_options::strategy == RELAX_GROW)
+            frag_base_addr.min = (frag_base_addr.min + mask) & ~mask;
     }
     std::cout << " -> " << frag_base_addr << std::endl;
 }
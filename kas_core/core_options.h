@@ -3,10 +3,14 @@
 
 #include "program_options/po_defn.h"
 #include "expr/expr_types.h"
+#include "kbfd/kbfd_compress.h"
 
 namespace kas::core
 {
 
+// values for `relax_options::strategy`
+enum { RELAX_FUZZ, RELAX_GROW };
+
 struct {
     bool    fold_data;
 
@@ -29,8 +33,21 @@ struct {
     uint8_t cont_lines;
 } listing_options;
 
+// options read outside the options translation unit
+// NB: static members (not unnamed struct) so all translation units share
+struct dwarf_options
+{
+    static inline bool line_direct;
+    static inline bool line_tune;
+    static inline bool eh_frame_hdr;
+};
+
+struct relax_options
+{
+    static inline uint8_t strategy;
+};
+
 struct {
-    uint8_t compression;
     uint8_t size_check;
     uint8_t use_stt_common;
     uint8_t no_pad_sections;
@@ -54,6 +71,8 @@ struct add_core_options
         auto& o = core_options;
         defns.add()
             ("-R"                     , "fold data section into text section"   , o.fold_data)
+            ("--relax,:, fuzz, grow"  , "branch relax strategy: shrink by fuzz, or optimistic grow"
+                                                                                , relax_options::strategy)
             
             // parsed & ignored
             ("--execstack"            , "require executable stack for this object")
@@ -67,11 +86,12 @@ struct add_core_options
     void do_elf(options::po_defns& defns) const
     {
         auto& o = elf_options;
+        auto& z = kbfd::kbfd_compress::mode;
         defns.add("ELF Options")
             ("--compress-debug-sections,:, none, zlib, zlib-gnu, zlib-gabi"
-                                  , "compress DWARF debug sections using zlib"  , o.compression)
+                                  , "compress DWARF debug sections using zlib"  , z)
             ("#--compress-debug-sections,--nocompress-debug-sections,=0,0"
-                                      , "don't compress DWARF debug sections"   , o.compression)
+                                      , "don't compress DWARF debug sections"   , z)
             ("--size-check,:error,error,warning"
                                       , "ELF .size directive check"             , o.size_check)
             ("--elf-stt-common"       , "generate ELF common symbols with STT_COMMON type"
@@ -84,6 +104,12 @@ struct add_core_options
             ("--gdwarf-2,=2"          , "generate DWARF2 debugging information" , o.dwarf_version)
             ("--gdwarf-4,=4"          , "generate DWARF2 debugging information" , o.dwarf_version)
             ("--gdwarf,:,4"           , "specify DWARF version"                 , o.dwarf_version)
+            ("--gdwarf-line-direct"   , "generate .debug_line from final addresses"
+                                                                                , dwarf_options::line_direct)
+            ("--gdwarf-line-tune"     , "choose .debug_line special opcode parameters"
+                                                                                , dwarf_options::line_tune)
+            ("--eh-frame-hdr"         , "generate .eh_frame_hdr lookup table (link without ld --eh-frame-hdr)"
+                                                                                , dwarf_options::eh_frame_hdr)
             
             // parsed & ignored
             ("--gstabs"               , "generate STABS debugging information")
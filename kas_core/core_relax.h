@@ -3,14 +3,35 @@
 
 
 #include "core_fits.h"
+#include "core_options.h"
+#include "core_stats.h"
+#include "core_trace.h"
+
+#include <sstream>
 
 namespace kas::core
 {
 
+//
+// Two strategies are available to relax a segment (selected by `--relax`)
+//
+// `fuzz`: (default) Each pass, insns which might fit within `fuzz` remain
+//         undecided. `fuzz` is reduced each pass until all insns resolved.
+//
+// `grow`: (optimistic) Assume each undecided insn has its minimum size.
+//         Each pass, grow only insns which don't fit the "minimum" layout.
+//         Since insns only grow, passes continue until no insn changes.
+//         The minimum layout is then consistent, so a final pass commits
+//         each undecided insn to its minimum size. Anything still undecided
+//         (eg: non-displacement expressions) is resolved using `fuzz`.
+//
+
 template <typename C>
 struct core_relax
 {
     using fuzz_t = typename frag_offset_t::value_t;
+    using mode_t = core_fits::fits_mode_t;
+
     static constexpr fuzz_t initial_fuzz = std::numeric_limits<int16_t>::max();
     
     // tuning function
@@ -39,11 +60,12 @@ struct core_relax
         return fuzz;
     }
 
-    auto relax_fn(fuzz_t fuzz)
+    // `changed`: if non-null, count insns whose size changed
+    auto relax_fn(fuzz_t fuzz, mode_t mode = core_fits::FUZZ, unsigned *changed = {})
     {
-        core_fits fits(c.get_insn_dot(), fuzz);
+        core_fits fits(&c.get_insn_dot(), fuzz, mode);
     
-        return [fits](auto& insn, core_expr_dot const&)
+        return [fits, changed](auto& insn, core_expr_dot const&)
             {
                 if (!insn.is_relaxed())
                 {
@@ -54,7 +76,10 @@ struct core_relax
                                << " from "  << insn.size();
                     }
 
+                    auto old_size = insn.size();
                     insn.calc_size(fits);
+                    if (changed && insn.size() != old_size)
+                        ++*changed;
 
                     if (trace)
                         *trace << " -> " << insn.size() << std::endl;
@@ -90,6 +115,15 @@ struct core_relax
         if (trace)
             *trace << "Relaxing segment: " << segment << std::endl;
 
+        // record passes for `--statistics`
+        std::ostringstream name;
+        name << segment;
+        auto& stats = core_stats::relax(name.str());
+        auto  start = core_stats::clock_t::now();
+
+        if (relax_options::strategy == RELAX_GROW)
+            relax_grow(segment, stats);
+
         auto fuzz = new_fuzz(segment.size());
         while(!segment.size().is_relaxed())
         {
@@ -97,6 +131,13 @@ struct core_relax
             if (trace)
                 *trace << "relax_seg:fuzz = " << fuzz << std::endl;
             
+            core_trace::span span("relax_pass", "relax");
+            if (span)
+                span.arg("segment", stats.segment)
+                    .arg("pass", stats.fuzz.size() + stats.grow)
+                    .arg("fuzz", fuzz);
+
+            stats.fuzz.push_back(fuzz);
             for (auto fp = segment.initial_relax(); fp; fp = fp->next_p())
                 relax_frag(*fp, fuzz);
             
@@ -107,11 +148,43 @@ struct core_relax
             fuzz = new_fuzz(segment.size(), fuzz);
         }
 
+        stats.wall = core_stats::clock_t::now() - start;
+
         if (trace)
             *trace << "Relax: segment " << segment << " done." << std::endl;
     }
 
-    void relax_frag(core_fragment& frag, fuzz_t fuzz)
+    // optimistic relax: grow until stable, then commit
+    void relax_grow(core_segment& segment, core_stats::relax_t& stats)
+    {
+        auto pass = [&](mode_t mode)
+            {
+                if (trace)
+                    *trace << "relax_seg:grow: mode = " << +mode << std::endl;
+
+                core_trace::span span("relax_pass", "relax");
+                if (span)
+                    span.arg("segment", stats.segment)
+                        .arg("pass", stats.fuzz.size() + stats.grow)
+                        .arg("mode", mode == core_fits::GROW ? "grow" : "commit");
+                
+                unsigned changed{};
+                ++stats.grow;
+                for (auto fp = segment.initial_relax(); fp; fp = fp->next_p())
+                    relax_frag(*fp, 0, mode, &changed);
+                return changed;
+            };
+
+        while (!segment.size().is_relaxed())
+            if (!pass(core_fits::GROW))
+            {
+                pass(core_fits::COMMIT);
+                break;
+            }
+    }
+
+    void relax_frag(core_fragment& frag, fuzz_t fuzz
+                  , mode_t mode = core_fits::FUZZ, unsigned *changed = {})
     {
         if (trace)
         {
@@ -132,7 +205,7 @@ struct core_relax
         }
         else 
         {
-            c.proc_frag(frag, relax_fn(fuzz));
+            c.proc_frag(frag, relax_fn(fuzz, mode, changed));
             if (trace)
                 *trace << " -> " << frag.size() << std::endl;
         }
@@ -146,6 +219,7 @@ struct core_relax
 template <typename C>
 void do_relax(C& c, std::ostream *trace = {})
 {
+    core_stats::timer t("relax");
     core_relax<C>::trace = trace;
     core_relax<C>{c}();
 }
@@ -0,0 +1,262 @@
+#ifndef KAS_CORE_CORE_STATS_H
+#define KAS_CORE_CORE_STATS_H
+
+//
+// core_stats: measured statistics from assembler execution
+//
+// Statistics are always accumulated (the cost is a few clock reads
+// per phase) and displayed by the driver when `--statistics` requested.
+//
+// Four types of statistics are collected:
+//
+// 1. phase timers: wall and cpu time for each named phase. Timers are
+//    created as RAII objects: `auto t = core_stats::timer("parse");`
+//    Repeated phases accumulate. Nested timers are exclusive: time in an
+//    inner phase (eg: `relax` during `emit`) is not charged to the outer
+//    phase, so reported phases don't overlap.
+//
+// 2. counters: fixed event counts (eg: instructions, relocations)
+//
+// 3. relax: per-segment pass counts and fuzz values used by `core_relax`
+//    (optimistic `grow` passes are counted separately)
+//
+// 4. memory: object count & bytes held by each `kas_object` obstack.
+//    `kas_object` registers each type when first object allocated.
+//
+
+#include <chrono>
+#include <ctime>
+#include <array>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <deque>
+#include <ostream>
+#include <iomanip>
+#include <algorithm>
+
+namespace kas::core
+{
+
+struct core_stats
+{
+    using clock_t    = std::chrono::steady_clock;
+    using duration_t = std::chrono::duration<double>;
+
+    struct phase_t
+    {
+        const char *name;
+        duration_t  wall {};
+        double      cpu  {};
+        unsigned    count{};
+    };
+
+    // counters: fixed indexes so counting is an increment
+    enum counter_id : uint8_t
+    {
+          CNT_STATEMENTS
+        , CNT_INSTRUCTIONS
+        , CNT_DEFERRED
+        , CNT_FRAGMENTS
+        , CNT_SYMBOLS
+        , CNT_EXPRESSIONS
+        , CNT_RELOCATIONS
+        , NUM_COUNTERS
+    };
+
+    static constexpr const char *counter_names[NUM_COUNTERS] =
+    {
+          "statements"
+        , "instructions"
+        , "deferred instructions"
+        , "fragments"
+        , "symbols"
+        , "expressions"
+        , "relocations"
+    };
+
+    struct relax_t
+    {
+        std::string         segment;
+        std::vector<long>   fuzz;       // fuzz value for each pass
+        unsigned            grow {};    // optimistic passes
+        duration_t          wall {};
+    };
+
+    // `kas_object` obstack accounting
+    struct obstack_t
+    {
+        std::string   name;
+        std::size_t   obj_size;
+        std::size_t (*num_objects)();
+        std::size_t   peak {};
+
+        std::size_t update()
+        {
+            return peak = std::max(peak, num_objects());
+        }
+    };
+
+    // RAII phase timer: pause enclosing timer while active
+    struct timer
+    {
+        timer(const char *name)
+            : phase(get_phase(name))
+            , outer(current())
+        {
+            if (outer)
+                outer->stop();
+            current() = this;
+            start();
+        }
+
+        ~timer()
+        {
+            stop();
+            ++phase.count;
+            current() = outer;
+            if (outer)
+                outer->start();
+        }
+
+    private:
+        void start()
+        {
+            wall_start = clock_t::now();
+            cpu_start  = std::clock();
+        }
+
+        void stop()
+        {
+            phase.wall += clock_t::now() - wall_start;
+            phase.cpu  += double(std::clock() - cpu_start) / CLOCKS_PER_SEC;
+        }
+
+        static timer*& current()
+        {
+            static timer *current_;
+            return current_;
+        }
+
+        phase_t&            phase;
+        timer              *outer;
+        clock_t::time_point wall_start;
+        std::clock_t        cpu_start;
+    };
+
+    // counter interface
+    static void count(counter_id id, std::size_t n = 1)
+    {
+        counters()[id] += n;
+    }
+
+    // relax interface: returns record to be updated by `core_relax`
+    static relax_t& relax(std::string segment)
+    {
+        return relaxes().emplace_back(relax_t{std::move(segment)});
+    }
+
+    // obstack interface: used by `kas_object`
+    static obstack_t& add_obstack(std::string name, std::size_t obj_size
+                                , std::size_t (*num_objects)())
+    {
+        return obstacks().emplace_back(obstack_t{std::move(name), obj_size, num_objects});
+    }
+
+    // record peak obstack usage (eg: before test fixture clears objects)
+    static void update_peaks()
+    {
+        for (auto& o : obstacks())
+            o.update();
+    }
+
+    template <typename OS> static void print(OS& os);
+
+private:
+    static phase_t& get_phase(const char *name)
+    {
+        auto& p = phases();
+        for (auto& ph : p)
+            if (!std::strcmp(ph.name, name))
+                return ph;
+        return p.emplace_back(phase_t{name});
+    }
+
+    // NB: allocate statics so they outlive `kas_object` instances
+    static std::deque<phase_t>& phases()
+    {
+        static auto _phases = new std::deque<phase_t>;
+        return *_phases;
+    }
+    static std::array<std::size_t, NUM_COUNTERS>& counters()
+    {
+        static std::array<std::size_t, NUM_COUNTERS> _counters;
+        return _counters;
+    }
+    static std::deque<relax_t>& relaxes()
+    {
+        static auto _relaxes = new std::deque<relax_t>;
+        return *_relaxes;
+    }
+    static std::deque<obstack_t>& obstacks()
+    {
+        static auto _obstacks = new std::deque<obstack_t>;
+        return *_obstacks;
+    }
+};
+
+template <typename OS>
+void core_stats::print(OS& os)
+{
+    auto flags = os.flags();
+    os << std::fixed << std::setprecision(6);
+
+    os << "\nStatistics:\n";
+    os << "\nphase                      wall(s)      cpu(s)  count\n";
+    for (auto& p : phases())
+    {
+        os << std::left  << std::setw(20) << p.name;
+        os << std::right << std::setw(14) << p.wall.count();
+        os << std::setw(12) << p.cpu;
+        os << std::setw(7)  << p.count << '\n';
+    }
+
+    os << "\ncounter                        value\n";
+    for (unsigned i = 0; i < NUM_COUNTERS; ++i)
+    {
+        os << std::left  << std::setw(24) << counter_names[i];
+        os << std::right << std::setw(12) << counters()[i] << '\n';
+    }
+
+    os << "\nrelax segment             passes    grow     wall(s)  fuzz\n";
+    for (auto& r : relaxes())
+    {
+        os << std::left  << std::setw(24) << r.segment;
+        os << std::right << std::setw(8)  << r.fuzz.size() + r.grow;
+        os << std::setw(8)  << r.grow;
+        os << std::setw(12) << r.wall.count() << ' ';
+        for (auto f : r.fuzz)
+            os << ' ' << f;
+        os << '\n';
+    }
+
+    os << "\nobstack                                     objects  obj size    peak bytes\n";
+    std::size_t total {};
+    for (auto& o : obstacks())
+    {
+        auto peak = o.update();
+        total += peak * o.obj_size;
+        os << std::left  << std::setw(40) << o.name.substr(0, 39);
+        os << std::right << std::setw(12) << peak;
+        os << std::setw(10) << o.obj_size;
+        os << std::setw(14) << peak * o.obj_size << '\n';
+    }
+    os << std::left << std::setw(62) << "total" << std::right;
+    os << std::setw(14) << total << '\n' << std::endl;
+
+    os.flags(flags);
+}
+
+}
+
+#endif
@@ -0,0 +1,137 @@
+#ifndef KAS_CORE_CORE_TRACE_H
+#define KAS_CORE_CORE_TRACE_H
+
+//
+// core_trace: performance trace in Chrome trace-event format
+//
+// Where `core_stats` summarizes time per phase, `core_trace` records a
+// timeline of individual operations (eg: each relax pass, each fragment)
+// suitable for viewing in `chrome://tracing` or `ui.perfetto.dev`.
+//
+// Spans are RAII objects:
+//
+//      core_trace::span s("relax_pass", "relax");
+//      if (s)
+//          s.arg("segment", name).arg("fuzz", fuzz);
+//
+// When no trace stream is open, a span is a single pointer test. Span
+// arguments should be guarded as above so they are not formatted unless
+// tracing. Completed spans are written as "complete" (`ph:X`) events.
+//
+
+#include <chrono>
+#include <string>
+#include <ostream>
+#include <type_traits>
+
+namespace kas::core
+{
+
+struct core_trace
+{
+    using clock_t = std::chrono::steady_clock;
+
+    // begin trace output to `os`
+    static void open(std::ostream& os)
+    {
+        out   = &os;
+        first = true;
+        epoch = clock_t::now();
+        *out << "[\n";
+    }
+
+    // terminate JSON array
+    static void close()
+    {
+        if (out)
+            *out << "\n]" << std::endl;
+        out = {};
+    }
+
+    static bool enabled() { return out; }
+
+    struct span
+    {
+        span(const char *name, const char *cat = "kas")
+            : name(name), cat(cat)
+        {
+            if (out)
+                start = clock_t::now();
+        }
+
+        ~span()
+        {
+            if (out)
+                emit(clock_t::now());
+        }
+
+        // test if tracing (ie: should args be generated)
+        explicit operator bool() const { return out; }
+
+        // append arguments: integral & string values
+        template <typename T>
+        span& arg(const char *key, T const& value)
+        {
+            if (out)
+            {
+                args += args.empty() ? "\"" : ",\"";
+                args += key;
+                args += "\":";
+                if constexpr (std::is_arithmetic_v<T>)
+                    args += std::to_string(value);
+                else
+                    args += quote(value);
+            }
+            return *this;
+        }
+
+    private:
+        void emit(clock_t::time_point end)
+        {
+            using us = std::chrono::microseconds;
+            auto ts  = std::chrono::duration_cast<us>(start - epoch).count();
+            auto dur = std::chrono::duration_cast<us>(end - start).count();
+
+            if (!first)
+                *out << ",\n";
+            first = false;
+
+            *out << "{\"name\":"   << quote(name);
+            *out << ",\"cat\":"    << quote(cat);
+            *out << ",\"ph\":\"X\",\"pid\":1,\"tid\":1";
+            *out << ",\"ts\":"     << ts;
+            *out << ",\"dur\":"    << dur;
+            if (!args.empty())
+                *out << ",\"args\":{" << args << '}';
+            *out << '}';
+        }
+
+        static std::string quote(std::string const& s)
+        {
+            std::string result{'"'};
+            for (auto c : s)
+            {
+                if (c == '"' || c == '\\')
+                    result += '\\';
+                if (static_cast<unsigned char>(c) < ' ')
+                    continue;       // drop control chars
+                result += c;
+            }
+            return result += '"';
+        }
+
+        const char         *name;
+        const char         *cat;
+        clock_t::time_point start;
+        std::string         args;
+    };
+
+private:
+    static inline std::ostream      *out;
+    static inline bool               first;
+    static inline clock_t::time_point epoch;
+};
+
+}
+
+#endif
@@ -65,6 +65,11 @@ public:
                 , uint8_t chunk_size
                 , unsigned num_chunks) override;
 
+    void put_fill(e_chan_num num
+                , uint8_t width
+                , int64_t data
+                , unsigned count) override;
+
     void put_symbol_reloc(
                   e_chan_num num
                 , kbfd::kbfd_target_reloc const& info
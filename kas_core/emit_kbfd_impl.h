@@ -2,6 +2,8 @@
 #define KAS_CORE_EMIT_KBFD_IMPL_H
 
 #include "emit_kbfd.h"
+#include "core_stats.h"
+#include "core_trace.h"
 
 #include "kbfd/kbfd_section_sym.h"
 #include "kbfd/kbfd_section_data.h"
@@ -101,6 +103,8 @@ void emit_kbfd::open()
 // write object data to stream
 void emit_kbfd::close()
 {
+    core_stats::timer t("write");
+    core_trace::span  s("kbfd_write", "write");
     kbfd_p->write(out);
 }
 
@@ -171,6 +175,16 @@ void emit_kbfd::put_data(e_chan_num num
         }
 }
 
+// NB: pattern replicated in section buffer (or skipped if `SHT_NOBITS`)
+void emit_kbfd::put_fill(e_chan_num num
+            , uint8_t width
+            , int64_t data
+            , unsigned count)
+{
+    if (do_emit(num))
+        ks_data_p->put_fill(data, width, count);
+}
+
 void emit_kbfd::put_diag(e_chan_num num, uint8_t width, parser::kas_diag_t const& diag) 
 {
     static constexpr char zero[8] = {};
@@ -234,6 +248,7 @@ void emit_kbfd::put_kbfd_reloc(
                 , bool     use_rela
                 ) const
 {
+    core_stats::count(core_stats::CNT_RELOCATIONS);
     if (use_rela)
         ks_data_p->put_reloc_a(info, sym_num, addend);
     else
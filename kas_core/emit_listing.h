@@ -33,6 +33,7 @@ Development plan:
 
 #include "emit_string.h"
 #include "core_options.h"
+#include <memory>
 #include <regex>
 
 namespace kas::core
@@ -98,10 +99,12 @@ private:
     // accumulate "listing" in `listing_line` instance
     //
 
+    // NB: per listing: line holds `out` stream
     auto& get_line()
     {
-        static listing_line<Iter> line{out, *this};
-        return line;
+        if (!line_p)
+            line_p = std::make_unique<listing_line<Iter>>(out, *this);
+        return *line_p;
     }
     
     // push listing after insn
@@ -111,16 +114,17 @@ private:
     void flush();
 
     // register source file
+    // NB: map by text, not file number: in-place expansions (eg: `.rept`
+    // body) are new file numbers for text of containing file
     auto prev_it(size_t num)
     {
-        auto it = current_pos.find(num);
+        auto bof = parser::error_handler<Iter>::extent(num).first;
+        auto it  = current_pos.find(&*bof);
         if (it != current_pos.end())
             return it;
         
-        // new file: register begin/end & try again
-        auto [bof, eof] = parser::error_handler<Iter>::extent(num);
-        current_pos.emplace(num, bof);
-        eof_pos    .emplace(num, eof);
+        // new text: register begin & try again
+        current_pos.emplace(&*bof, bof);
         return prev_it(num);
     }
 
@@ -139,9 +143,9 @@ private:
     std::array<std::vector<std::string>, NUM_EMIT_FMT> buffers{};
     std::list<parser::kas_diag_t::index_t> diagnostics;
     std::list<std::string> relocs;
-    std::map<size_t, Iter> current_pos;     // walk thru source files
-    std::map<size_t, Iter> eof_pos;         // end `loc` of source files
+    std::map<void const *, Iter> current_pos;   // walk thru source files
     parser::kas_loc  prev_loc;
+    std::unique_ptr<listing_line<Iter>> line_p;
 
     // "map" diagnostics by "loc"
     using diag_iter_t = typename diag_map_t::iterator;
@@ -171,6 +175,7 @@ struct listing_line
     void append_diag(diag_type&, parser::kas_loc const&);
     void append_reloc(reloc_type&);
     Iter emit_line(Iter first, Iter const& last, bool flush = {});
+    void emit_data();
 private:
     void do_emit(Iter first, Iter const& last);
 
@@ -198,9 +203,19 @@ void emit_listing<Iter>::gen_listing(core_expr_dot const& dot, parser::kas_loc l
     ////std::cout << "emit_listing: insn_loc = " << loc.get();
     ////std::cout << ", src = " << loc.where() << std::endl;
 
-    // don't generate listing for internally generated insns
+    // internally generated insns (eg: pooled data) are listed without source
     if (!loc)
+    {
+        if (!buffers[EMIT_DATA].empty())
+        {
+            line.gen_addr(buffers[EMIT_ADDR], dot);
+            line.gen_data(buffers[EMIT_DATA]);
+            line.append_reloc(relocs);
+            buffers = {};
+            line.emit_data();
+        }
         return;
+    }
 
     if (prev_loc && !(prev_loc < loc))
         throw std::logic_error{"Backwards listing: src = " + loc.where()};
@@ -214,13 +229,23 @@ void emit_listing<Iter>::gen_listing(core_expr_dot const& dot, parser::kas_loc l
 
     // get iter to where in the source file we left off
     auto& prev = prev_it(idx)->second;
+    auto  pos  = prev;
+
+    // text listed before (eg: repeated `.rept` body) is listed again
+    // from beginning of line. Resume text after `prev`
+    if (first < prev)
+    {
+        auto bof = parser::error_handler<Iter>::extent(idx).first;
+        for (pos = first; pos != bof && *std::prev(pos) != '\n'; --pos)
+            ;
+    }
 
     // finish `prev_loc` insn with any pending diagnostics
     line.append_diag(diagnostics, prev_loc);
 
     // emit (comment) lines with no object code before this insn
     // NB: only emits complete source code lines (which end with new-line)
-    prev = line.emit_line(prev, first);
+    pos = line.emit_line(pos, first);
 
     // format collected object code for this insn
     line.gen_addr(buffers[EMIT_ADDR], dot);
@@ -236,7 +261,9 @@ void emit_listing<Iter>::gen_listing(core_expr_dot const& dot, parser::kas_loc l
     // emit source and formatted object code
     // NB: only emits complete source code lines (which end with new-line)
     // NB: lines with comments and/or multiple insns are left in buffers
-    prev = line.emit_line(prev, last);
+    pos = line.emit_line(pos, last);
+    if (prev < pos)
+        prev = pos;
 }
 
 template <typename Iter>
@@ -252,7 +279,7 @@ void emit_listing<Iter>::flush()
     auto& prev = prev_it(idx)->second;
     
     // get iter to end-of-file
-    auto& eof  = eof_pos.find(idx)->second;
+    auto eof = parser::error_handler<Iter>::extent(idx).second;
 
     get_line().emit_line(prev, eof, true); 
 }
@@ -381,6 +408,14 @@ Iter listing_line<Iter>::emit_line(Iter first, Iter const& last, bool flush)
     return emit_line(next, last);
 }
 
+// emit object code without source
+template <typename Iter>
+void listing_line<Iter>::emit_data()
+{
+    static const std::string eol{"\n"};
+    emit_line(eol.cbegin(), eol.cend());
+}
+
 template <typename Iter>
 void listing_line<Iter>::do_emit(Iter first, Iter const& last)
 {
@@ -54,6 +54,12 @@ struct emit_stream_base
                        , void const *p
                        , uint8_t     width 
                        , unsigned    count);
+
+    // emit `count` copies of single value (with byte swapping)
+    virtual void put_fill(e_chan_num num
+                       , uint8_t      width
+                       , emit_value_t data
+                       , unsigned     count);
     
     // NB: if backend emits `REL_A` or otherwise consumes `addend`
     // it must zero addend
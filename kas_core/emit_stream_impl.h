@@ -60,6 +60,16 @@ void emit_stream_base::put_data(e_chan_num num
     }
 }
 
+// emit `count` copies of single value (with byte swapping)
+void emit_stream_base::put_fill(e_chan_num num
+                   , uint8_t      width
+                   , emit_value_t data
+                   , unsigned     count)
+{
+    while (count--)
+        put_uint(num, width, data);
+}
+
 // trampoline functions
 void emit_stream_base::set_segment(core_segment const& segment)
 {
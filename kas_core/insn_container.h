@@ -43,6 +43,7 @@ Forward-Inserter
 #include "core_addr.h"
 #include "core_expr_dot.h"
 #include "core_symbol.h"
+#include "core_trace.h"
 
 #include "opc_misc.h"
 #include "opc_symbol.h"
@@ -208,6 +209,10 @@ namespace kas::core
     {
         assert(insn_iters);
 
+        core_trace::span span("proc_frag", "frag");
+        if (span)
+            span.arg("frag", frag.frag_num());
+
         unsigned index = frag.frag_num() - first_frag_p->frag_num();
         if (index < insn_iters->size()) 
             do_frag(frag, (*insn_iters)[index], fn);
@@ -9,10 +9,15 @@
 #include "core_symbol.h"
 
 #include "opc_misc.h"
+#include "opc_incbin.h"
+#include "opc_merge.h"
+#include "opc_literal.h"
 #include "opc_symbol.h"
 #include "opc_segment.h"
 
 #include <limits>
+#include <set>
+#include <vector>
 #include <cassert>
 
 namespace kas::core
@@ -57,6 +62,12 @@ struct insn_inserter
     value_t& put_segment(value_t&&);
     void put_align  (value_t&&);
     value_t& put_org    (value_t&&);
+    void put_chunk  (core_insn&&);
+    void put_merge_ref(value_t&&);
+    void put_merge_pools();
+    void put_literals();
+    void put_literal_pool(core_literal_pool&);
+    void put_literal_pools();
 
     void reserve(op_size_t const&);
 
@@ -69,8 +80,10 @@ struct insn_inserter
     // `dot` used while inserting insns
     core_expr_dot dot;
 
+    // labels defined at current location (for `opc_merge_ref`)
+    std::vector<core_addr_t *> dot_labels;
+
     // frag tuning variables...
-    size_offset_t offset;
     uint16_t frag_insn_max  {};
     uint16_t frag_relax_max {};
 
@@ -104,6 +117,8 @@ insn_inserter<INSN_DATA_T>::insn_inserter(CONTAINER_T& c)
 template <typename INSN_DATA_T>
 insn_inserter<INSN_DATA_T>::~insn_inserter()
 {
+    put_literal_pools();
+    put_merge_pools();
     at_end_fn(cb_container_p, *this);
 }
 
@@ -116,6 +131,10 @@ auto insn_inserter<INSN_DATA_T>::operator=(core_insn&& insn) -> insn_inserter&
     static const auto idx_org     = opc::opc_org()    .index();
     static const auto idx_align   = opc::opc_align()  .index();
     static const auto idx_label   = opc::opc_label()  .index();
+    static const auto idx_incbin  = opc::opc_incbin() .index();
+    static const auto idx_fill    = opc::opc_fill()   .index();
+    static const auto idx_merge   = opc::opc_merge_ref().index();
+    static const auto idx_ltorg   = opc::opc_literal_pool().index();
 
     // generate container_data from insn
     value_t data{insn};
@@ -141,19 +160,52 @@ auto insn_inserter<INSN_DATA_T>::operator=(core_insn&& insn) -> insn_inserter&
         put_org(std::move(data));
     else if (opc_index == idx_align)
         put_align(std::move(data));
+    else if (opc_index == idx_merge)
+        put_merge_ref(std::move(data));
     else if (opc_index != idx_label)
         put_insn(std::move(data));
 
+    // values loaded from literal pool by inserted insn
+    if (core_literal_pool::has_pending())
+        put_literals();
+
     // move dot if object code emitted data
     if (insn_size.max)
     {
         core_addr_t::new_dot();
         dot.dot_offset += insn_size;
+        dot_labels.clear();
     }
 
+    // large `incbin` ranges are inserted as series of chunks
+    // NB: `opc_incbin` holds range. Don't recurse per chunk.
+    if (opc_index == idx_incbin)
+        while (opc::opc_incbin::more())
+            put_chunk(opc::opc_incbin());
+    else if (opc_index == idx_fill)
+        while (opc::opc_fill::more())
+            put_chunk(opc::opc_fill());
+
+    // place literal pool for current section
+    else if (opc_index == idx_ltorg)
+        put_literal_pool(core_literal_pool::get(frag_p->segment().section()));
+
     return *this;
 }
 
+// insert insn: continuation of bulk data (no special processing)
+template <typename INSN_DATA_T>
+void insn_inserter<INSN_DATA_T>::put_chunk(core_insn&& insn)
+{
+    value_t data{insn};
+    reserve(data.size());
+    insn_size = insn.data.size;
+    put_insn(std::move(data));
+
+    core_addr_t::new_dot();
+    dot.dot_offset += insn_size;
+}
+
 // insert insn: generic instruction
 template <typename INSN_DATA_T>
 auto insn_inserter<INSN_DATA_T>::put_insn(value_t&& data) -> value_t&
@@ -197,6 +249,107 @@ void insn_inserter<INSN_DATA_T>::put_label(value_t&& data)
         addr_p = &core_addr_t::cur_dot();
 
     addr_p->init_addr(frag_p, &fixed.offset);
+    dot_labels.push_back(addr_p);
+}
+
+// insert insn: string pooled in mergeable section
+template <typename INSN_DATA_T>
+void insn_inserter<INSN_DATA_T>::put_merge_ref(value_t&& data)
+{
+    // pool for current section. Strings in other sections stay in place
+    auto ref = opc::opc_merge_ref::place(frag_p->segment().section());
+    data.fixed.fixed = ref;
+    if (opc::opc_merge_ref::in_place(ref))
+    {
+        insn_size = insn_size.max;
+        data.update(insn_size);
+        put_insn(std::move(data));
+        return;
+    }
+
+    // labels at this location are bound to pooled string
+    // NB: `opc_merge_ref` holds string. Size is chosen with placement
+    put_insn(std::move(data));
+    for (auto addr_p : dot_labels)
+        opc::opc_merge_ref::bind(*addr_p);
+}
+
+// append pooled strings to their sections
+template <typename INSN_DATA_T>
+void insn_inserter<INSN_DATA_T>::put_merge_pools()
+{
+    using chunk_t = opc::opc_merge_data;
+    static constexpr auto max_chunk = core_merge_strings::max_chunk;
+
+    // moving strings would alter a difference of locations in section
+    std::set<core_section const *> diff_sections;
+    if (core_merge_strings::size())
+        diff_sections = core_expr_t::diff_sections();
+
+    unsigned n {};
+    core_merge_strings::for_each([&](auto& pool)
+        {
+            // NB: pools are appended by first container completed
+            ++n;
+            if (pool.flushed)
+                return;
+            if (diff_sections.count(&pool.section))
+            {
+                pool.flushed = pool.in_place = true;
+                return;
+            }
+            pool.layout();
+            *this = {opc::opc_segment(), pool.section.segment()};
+
+            // each chunk begins new frag: label offsets are relative to chunk
+            std::vector<core_fragment const *> frags;
+            for (uint32_t offset = 0; offset < pool.data.size(); offset += max_chunk)
+            {
+                auto count = std::min<uint32_t>(pool.data.size() - offset, max_chunk);
+                new_frag();
+                put_chunk({chunk_t(), n, offset, count});
+                frags.push_back(frag_p);
+            }
+            pool.bind_all(frags);
+        });
+}
+
+// add literals loaded by insn to pool for current section
+template <typename INSN_DATA_T>
+void insn_inserter<INSN_DATA_T>::put_literals()
+{
+    core_literal_pool::get(frag_p->segment().section()).add_pending();
+}
+
+// place literal pool at current location: each entry preceeded by label
+template <typename INSN_DATA_T>
+void insn_inserter<INSN_DATA_T>::put_literal_pool(core_literal_pool& pool)
+{
+    if (pool.empty())
+        return;
+
+    new_frag(core_literal_pool::entry_align);
+    for (auto& entry : pool.entries)
+    {
+        core_insn label{opc::opc_label(), *entry.addr_p};
+        put_label(value_t{label});
+        put_chunk({opc::opc_literal_data(), entry.value});
+    }
+    pool.bind_all();
+    dot_labels.clear();
+}
+
+// append unplaced literal pools to their sections
+template <typename INSN_DATA_T>
+void insn_inserter<INSN_DATA_T>::put_literal_pools()
+{
+    core_literal_pool::for_each([&](auto& pool)
+        {
+            if (pool.empty())
+                return;
+            *this = {opc::opc_segment(), pool.section.segment()};
+            put_literal_pool(pool);
+        });
 }
 
 // insert insn: segment
@@ -292,6 +445,7 @@ void insn_inserter<INSN_DATA_T>::new_frag(uint8_t align, core_segment *seg_p)
         
     // allocate new frag. possibly in new segment
     frag_p = &core_fragment::add(seg_p, align);
+    dot_labels.clear();
 
     // clear fragment tuning counts
     dot.set_frag(*frag_p);
@@ -302,8 +456,8 @@ void insn_inserter<INSN_DATA_T>::new_frag(uint8_t align, core_segment *seg_p)
 template <typename INSN_DATA_T>
 void insn_inserter<INSN_DATA_T>::reserve(op_size_t const& op_size)
 {
-    // if offset type overflows, then new frag
-    if (!offset.can_add(op_size))
+    // if frag offset type overflows, then new frag
+    if (!dot.frag_offset().can_add(op_size))
         return new_frag();
 
     // test tuning variables for new frag
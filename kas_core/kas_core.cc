@@ -64,6 +64,8 @@ namespace kas::core
     template void core_addr_t  ::print(std::ostream&) const;
     template void core_symbol_t::print(std::ostream&) const;
 
+    template std::set<core_section const *> core_expr_t::diff_sections();
+
     template void addr_ref     ::print(std::ostream&) const;
     template void symbol_ref   ::print(std::ostream&) const;
     //template void missing_ref  ::print(std::ostream&) const;
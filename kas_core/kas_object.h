@@ -7,6 +7,7 @@
 
 #include "ref_loc_t.h"
 #include "kas_clear.h"
+#include "core_stats.h"
 
 #include <deque>
 #include <new>
@@ -63,9 +64,17 @@ struct kas_object : kas_object_tag
 
 
 protected:
-    static auto& obstack()
+    static std::deque<Derived, Allocator<Derived>>& obstack()
     {
         static auto deque_ = new std::deque<Derived, Allocator<Derived>>;
+
+        // register obstack for `--statistics`
+        static auto& stats_ = core_stats::add_obstack(
+                  boost::typeindex::type_id<derived_t>().pretty_name()
+                , sizeof(derived_t)
+                , [] { return deque_->size(); }
+                );
+        (void)stats_;
         return *deque_;
     }
 
@@ -198,6 +207,7 @@ public:
     static void obj_clear()
     {
         //print_type_name{"kas_object: clear"}.name<derived_t>();
+        core_stats::update_peaks();
         derived_t::clear();
         obstack().clear();
     }
@@ -29,7 +29,22 @@ struct gen_eh_frame_ops : core_section::deferred_ops
     void gen_data(insn_inserter_t&& inserter) override
     {
         std::cout << "gen_eh_frame_ops::gen_data" << std::endl;
-        //dwarf::dwarf_frame_gen(std::move(inserter));
+        dwarf::dwarf_frame_gen(std::move(inserter), true);
+    }
+};
+
+// NB: construct after `gen_eh_frame_ops`: `.eh_frame` must be generated first
+struct gen_eh_frame_hdr_ops : core_section::deferred_ops
+{
+    gen_eh_frame_hdr_ops()
+    {
+        auto& s = core_section::get(".eh_frame_hdr", SHT_PROGBITS, SHF_ALLOC);
+        s.set_deferred_ops(*this);
+    }
+
+    void gen_data(insn_inserter_t&& inserter) override
+    {
+        dwarf::dwarf_frame_hdr_gen(std::move(inserter));
     }
 };
 
@@ -91,6 +106,10 @@ struct opc_df_oper : opcode
     static void gen_eh_frame()
     {
         static gen_eh_frame_ops _;    // schedule generation of `.eh_frame`
+        if (dwarf_options::eh_frame_hdr)
+        {
+            static gen_eh_frame_hdr_ops hdr;
+        }
     }
     static void gen_eh_frame_entry()
     {
@@ -122,6 +141,7 @@ struct opc_df_oper : opcode
             // NB: case 1: omit prologue
             // ... future....
             info_p = &dw_frame_data::add_frame(args.size());
+            info_p->loc = loc;
             args.clear();
         }
         
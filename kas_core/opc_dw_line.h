@@ -109,13 +109,13 @@ struct opc_dw_line : opcode
     {
         static gen_debug_line _;    // schedule generation of `.debug_line`
 
-		auto& obj = dl_data::add(file, line, dw_data, cnt);
+		auto obj = dl_data::add(file, line, dw_data, cnt);
 		data.fixed.fixed = obj.index();
 	}
 
 	void fmt(data_t const& data, std::ostream& os) const override
 	{
-		auto& obj = dl_data::get(data.fixed.fixed);
+		auto obj = dl_data::get(data.fixed.fixed);
 
         os << obj.line_num();
         if (obj.segment())
@@ -128,7 +128,7 @@ struct opc_dw_line : opcode
 	// emit records `dot` in `dwarf_line` entry for use generating `.debug_line`
 	void emit(data_t const& data, core_emit& base, core_expr_dot const *dot_p) const override
 	{
-		auto& obj     = dl_data::get(data.fixed.fixed);
+		auto obj      = dl_data::get(data.fixed.fixed);
 		obj.segment() = dot_p->segment().index();
 		obj.address() = dot_p->offset()();
 	}
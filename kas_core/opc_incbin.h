@@ -0,0 +1,181 @@
+#ifndef KAS_CORE_OPC_INCBIN_H
+#define KAS_CORE_OPC_INCBIN_H
+
+// opc_incbin: include binary file contents (`.incbin`)
+//
+// Binary files are memory-mapped (read-only) when first referenced. Each
+// file is mapped once, regardless of number of `.incbin` references.
+//
+// An `incbin` insn records only {file, offset, count}: no data is copied
+// during parse or relax. At emit time the mapped range is copied directly
+// into the object section buffer.
+//
+// Insn sizes are `op_size_t` (16 bits), so large ranges are inserted as
+// a series of `max_chunk` sized insns. The first chunk is generated by
+// `proc_args`. `insn_inserter` inserts the rest while `more` is true.
+
+#include "opcode.h"
+#include "kas_clear.h"
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <algorithm>
+#include <deque>
+#include <map>
+#include <string>
+
+namespace kas::core
+{
+
+struct core_incbin
+{
+    // map file: return index. on error, return zero & set `err`
+    static unsigned add(std::string const& path, const char *& err)
+    {
+        namespace bip = boost::interprocess;
+
+        auto& idx = index()[path];
+        if (idx)
+            return idx;
+
+        auto& f = files().emplace_back();
+        f.path  = path;
+        try
+        {
+            f.mapping = bip::file_mapping(path.c_str(), bip::read_only);
+            f.region  = bip::mapped_region(f.mapping, bip::read_only);
+        }
+        catch (bip::interprocess_exception const& e)
+        {
+            // NB: can't map empty file. treat as zero size
+            if (e.get_error_code() != bip::size_error)
+            {
+                files().pop_back();
+                index().erase(path);
+                err = "can't open file";
+                return {};
+            }
+        }
+
+        return idx = files().size();
+    }
+
+    static auto& get(unsigned idx)
+    {
+        return files()[idx - 1];
+    }
+
+    // number of files referenced
+    static auto size()
+    {
+        return files().size();
+    }
+
+    auto data() const
+    {
+        return static_cast<const char *>(region.get_address());
+    }
+
+    std::size_t file_size() const
+    {
+        return region.get_size();
+    }
+
+    std::string path;
+
+private:
+    static std::deque<core_incbin>& files()
+    {
+        static std::deque<core_incbin> files_;
+        return files_;
+    }
+
+    static std::map<std::string, unsigned>& index()
+    {
+        static std::map<std::string, unsigned> index_;
+        return index_;
+    }
+
+    static void clear()
+    {
+        files().clear();
+        index().clear();
+    }
+
+    static inline kas_clear _c{clear};
+
+    boost::interprocess::file_mapping  mapping;
+    boost::interprocess::mapped_region region;
+};
+
+}
+
+namespace kas::core::opc
+{
+    struct opc_incbin : opcode
+    {
+        OPC_INDEX();
+        const char *name() const override { return "INCBIN"; }
+
+        // largest range held in single insn
+        static constexpr uint32_t max_chunk = 1 << 15;
+
+        // single chunk: file index, file offset, byte count
+        void operator()(data_t& data, uint32_t file, uint32_t offset, uint32_t count) const
+        {
+            data.fixed.fixed = file;
+            data.size        = count;
+            auto& di = data.di();
+            *di++ = offset;
+        }
+
+        // next chunk of range from `proc_args`
+        void operator()(data_t& data) const
+        {
+            auto n = std::min(pending.count, max_chunk);
+            (*this)(data, pending.file, pending.offset, n);
+            pending.offset += n;
+            pending.count  -= n;
+        }
+
+        // args are validated by front-end
+        void proc_args(data_t& data, uint32_t file, uint32_t skip, uint32_t count)
+        {
+            pending = { file, skip, count };
+            (*this)(data);
+        }
+
+        // test if chunks remain to be inserted
+        static bool more()
+        {
+            return pending.count;
+        }
+
+        void fmt(data_t const& data, std::ostream& os) const override
+        {
+            auto iter = data.iter();
+            os << core_incbin::get(data.fixed.fixed).path;
+            os << ", " << *iter << ", " << data.size();
+        }
+
+        void emit(data_t const& data, core_emit& base, core_expr_dot const *dot_p) const override
+        {
+            auto& file   = core_incbin::get(data.fixed.fixed);
+            auto  offset = *data.iter()->get_fixed_p();
+            base << emit_data(sizeof(char), data.size()) << file.data() + offset;
+        }
+
+    private:
+        struct pending_t
+        {
+            uint32_t file;
+            uint32_t offset;
+            uint32_t count;
+        };
+
+        static inline pending_t pending;
+    };
+}
+
+#endif
@@ -0,0 +1,228 @@
+#ifndef KAS_CORE_OPC_LITERAL_H
+#define KAS_CORE_OPC_LITERAL_H
+
+// opc_literal: literal pools (eg: ARM `ldr rX, =value`)
+//
+// A target which loads values from a pc-relative literal pool calls
+// `core_literal_pool::add` as the insn is parsed. This allocates an
+// unbound `core_addr` to use as the load address & records the value
+// as `pending`.
+//
+// `insn_inserter` adds pending values to the pool for the section in
+// which the loading insn is inserted. Equal constants & equal `symbol +
+// offset` values share a single pool entry.
+//
+// A pool is placed by an `opc_literal_pool` insn (eg: `.ltorg`). Pools
+// not otherwise placed are appended to their section when insertion
+// completes. Each entry is a word preceeded by a label for the entry
+// address. Since labels are ordinary frag addresses, pool placement &
+// load displacements are resolved together by relax. Values added after
+// a pool is placed begin a new pool.
+//
+// Pools are only placed as described above: no pool is placed to keep an
+// entry in range of its load. A load whose entry is out of range (eg: more
+// than 4K bytes for A32 `ldr`) is reported by the target's reloc range
+// check & needs an explicit `.ltorg`.
+
+#include "opcode.h"
+#include "core_section.h"
+#include "core_segment.h"
+#include "core_fragment.h"
+#include "core_addr.h"
+#include "core_expr_type.h"
+#include "kas_clear.h"
+
+#include <deque>
+#include <map>
+#include <optional>
+#include <vector>
+
+namespace kas::core
+{
+
+struct core_literal_pool
+{
+    // pool entries are words & are word aligned
+    static constexpr uint8_t entry_size  = 4;
+    static constexpr uint8_t entry_align = 2;   // log2
+
+    core_literal_pool(core_section const& section) : section(section) {}
+
+    // allocate address for `value`. Bound to entry when insn inserted
+    static core_addr_t& add(expr_t const& value)
+    {
+        auto& addr = core_addr_t::add();
+        pending().emplace_back(value, &addr);
+        return addr;
+    }
+
+    static bool has_pending()
+    {
+        return !pending().empty();
+    }
+
+    // get pool for section
+    static auto& get(core_section const& s)
+    {
+        auto& p = index()[&s];
+        if (!p)
+            p = &pools().emplace_back(s);
+        return *p;
+    }
+
+    template <typename FN>
+    static void for_each(FN fn)
+    {
+        for (auto& pool : pools())
+            fn(pool);
+    }
+
+    // retrieve value stored for entry
+    static auto& value(unsigned n)
+    {
+        return values()[n - 1];
+    }
+
+    // add pending values to pool
+    void add_pending()
+    {
+        for (auto& [value, addr_p] : pending())
+        {
+            if (auto key = get_key(value))
+            {
+                auto [it, inserted] = by_value.try_emplace(*key, entries.size());
+                if (!inserted)
+                {
+                    aliases.emplace_back(it->second, addr_p);
+                    continue;
+                }
+            }
+            values().push_back(value);
+            entries.push_back({ static_cast<unsigned>(values().size()), addr_p });
+        }
+        pending().clear();
+    }
+
+    // bind duplicate values to placed entries & begin new pool
+    void bind_all()
+    {
+        for (auto& [idx, addr_p] : aliases)
+        {
+            auto& addr = *entries[idx].addr_p;
+            addr_p->init_addr(addr.frag_p, addr.offset_p);
+        }
+        entries.clear();
+        aliases.clear();
+        by_value.clear();
+    }
+
+    bool empty() const
+    {
+        return entries.empty();
+    }
+
+    // entry: value number & address of entry
+    struct entry_t
+    {
+        unsigned     value;
+        core_addr_t *addr_p;
+    };
+
+    core_section const& section;
+    std::vector<entry_t> entries;   // entries in current pool
+
+private:
+    // values with same key share entry: constants & `symbol + offset`
+    using key_t = std::pair<void const *, e_fixed_t>;
+    static std::optional<key_t> get_key(expr_t const& value)
+    {
+        if (auto p = value.get_fixed_p())
+            return key_t{ nullptr, *p };
+        if (auto p = value.template get_p<core_symbol_t>())
+            return key_t{ p, 0 };
+        if (auto p = value.template get_p<core_addr_t>())
+            return key_t{ p, 0 };
+        if (auto p = value.template get_p<core_expr_t>())
+        {
+            e_fixed_t offset {};
+            if (auto sym_p = p->get_symbol_p(offset))
+                return key_t{ sym_p, offset };
+        }
+        return {};
+    }
+
+    static std::deque<core_literal_pool>& pools()
+    {
+        static std::deque<core_literal_pool> pools_;
+        return pools_;
+    }
+
+    static std::map<core_section const *, core_literal_pool *>& index()
+    {
+        static std::map<core_section const *, core_literal_pool *> index_;
+        return index_;
+    }
+
+    static std::deque<expr_t>& values()
+    {
+        static std::deque<expr_t> values_;
+        return values_;
+    }
+
+    static std::vector<std::pair<expr_t, core_addr_t *>>& pending()
+    {
+        static std::vector<std::pair<expr_t, core_addr_t *>> pending_;
+        return pending_;
+    }
+
+    static void clear()
+    {
+        pools().clear();
+        index().clear();
+        values().clear();
+        pending().clear();
+    }
+
+    static inline kas_clear _c{clear};
+
+    std::map<key_t, unsigned>                       by_value;
+    std::vector<std::pair<unsigned, core_addr_t *>> aliases;
+};
+
+}
+
+namespace kas::core::opc
+{
+    // place literal pool for current section (eg: `.ltorg`): size zero
+    struct opc_literal_pool : opcode
+    {
+        OPC_INDEX();
+        const char *name() const override { return "LTORG"; }
+    };
+
+    // single literal pool entry: value number
+    struct opc_literal_data : opcode
+    {
+        OPC_INDEX();
+        const char *name() const override { return "LITERAL"; }
+
+        void operator()(data_t& data, unsigned value) const
+        {
+            data.fixed.fixed = value;
+            data.size        = core_literal_pool::entry_size;
+        }
+
+        void fmt(data_t const& data, std::ostream& os) const override
+        {
+            os << core_literal_pool::value(data.fixed.fixed);
+        }
+
+        void emit(data_t const& data, core_emit& base, core_expr_dot const *dot_p) const override
+        {
+            base << set_size(core_literal_pool::entry_size);
+            base << core_literal_pool::value(data.fixed.fixed);
+        }
+    };
+}
+
+#endif
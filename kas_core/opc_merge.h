@@ -0,0 +1,291 @@
+#ifndef KAS_CORE_OPC_MERGE_H
+#define KAS_CORE_OPC_MERGE_H
+
+// opc_merge: pool strings in mergeable string sections
+//
+// Strings assembled into `SHF_MERGE | SHF_STRINGS` sections (eg:
+// `.rodata.str1.1`) are added to a per-section pool & an `opc_merge_ref`
+// insn is inserted. `insn_inserter` binds labels at the `opc_merge_ref`
+// location to the pool entry.
+//
+// When insertion completes, the placement of each pool is chosen. If any
+// expression subtracts two locations in the section (eg: `.Le - .Ls` or
+// `. - .Ls`), moving strings would change the difference, so each string
+// is emitted in place & labels are not rebound.
+//
+// Otherwise the `opc_merge_ref` insns are zero-size & the pool is laid
+// out: equal strings are stored once & a string which is the tail of
+// another shares the longer copy. The pool is appended to its section as
+// a series of `max_chunk` sized `opc_merge_data` insns (each in its own
+// frag) & the bound labels are set to the pooled copies.
+//
+// Only single-string statements of byte characters (eg: `.asciz`) are
+// pooled. Others are inserted in place. The section is chosen by
+// `insn_inserter` when the `opc_merge_ref` is inserted: strings inserted
+// into other sections use a pool which is always emitted in place.
+
+#include "opcode.h"
+#include "core_section.h"
+#include "core_segment.h"
+#include "core_fragment.h"
+#include "core_addr.h"
+#include "kas_clear.h"
+#include "kbfd/kbfd_string_layout.h"
+
+#include <deque>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace kas::core
+{
+
+struct core_merge_strings
+{
+    // largest pool range held in single insn
+    static constexpr uint32_t max_chunk = 1 << 15;
+
+    core_merge_strings(core_section const& section) : section(section) {}
+
+    // test if strings in section should be pooled
+    static bool is_merge(core_section const& s)
+    {
+        constexpr auto flags = SHF_MERGE | SHF_STRINGS;
+        return (s.sh_flags & flags) == flags && s.ent_size() == 1;
+    }
+
+    // get pool for section. return 1-based pool number
+    // NB: strings in other sections are never moved
+    static unsigned get(core_section const& s)
+    {
+        auto& n = index()[&s];
+        if (!n)
+        {
+            auto& pool = pools().emplace_back(s);
+            pool.flushed = pool.in_place = !is_merge(s);
+            n = pools().size();
+        }
+        return n;
+    }
+
+    static auto& get(unsigned n)
+    {
+        return pools()[n - 1];
+    }
+
+    static auto size()
+    {
+        return pools().size();
+    }
+
+    template <typename FN>
+    static void for_each(FN fn)
+    {
+        for (auto& pool : pools())
+            fn(pool);
+    }
+
+    // add null-terminated string. return index
+    unsigned add(std::string const& str)
+    {
+        auto [it, inserted] = by_value.try_emplace(str + '\0', strings.size());
+        if (inserted)
+            strings.push_back(&it->first);
+        return it->second;
+    }
+
+    auto& operator[](unsigned idx) const
+    {
+        return *strings[idx];
+    }
+
+    // bind address to string
+    void bind(unsigned idx, core_addr_t& addr)
+    {
+        bindings.emplace_back(idx, &addr);
+    }
+
+    // strings which are tails of a string share it
+    void layout()
+    {
+        flushed = true;
+        offsets = kbfd::tail_share_layout<uint32_t>(strings.size()
+                        , [this](auto n) { return std::string_view(*strings[n]); }
+                        , [this](auto n)
+                            {
+                                uint32_t offset = data.size();
+                                data += *strings[n];
+                                return offset;
+                            });
+    }
+
+    // set bound addresses: each `max_chunk` of data begins a frag
+    void bind_all(std::vector<core_fragment const *> const& frags)
+    {
+        for (auto& [idx, addr_p] : bindings)
+        {
+            auto  offset = offsets[idx];
+            auto& frag_offset = label_offsets.emplace_back(offset % max_chunk);
+            addr_p->init_addr(frags[offset / max_chunk], &frag_offset);
+        }
+        bindings.clear();
+    }
+
+    core_section const& section;
+    std::string         data;       // layout of pooled strings
+    bool                flushed {}; // pool appended to section
+    bool                in_place{}; // strings not moved (see above)
+
+private:
+    static std::deque<core_merge_strings>& pools()
+    {
+        static std::deque<core_merge_strings> pools_;
+        return pools_;
+    }
+
+    static std::map<core_section const *, unsigned>& index()
+    {
+        static std::map<core_section const *, unsigned> index_;
+        return index_;
+    }
+
+    static void clear()
+    {
+        pools().clear();
+        index().clear();
+    }
+
+    static inline kas_clear _c{clear};
+
+    std::unordered_map<std::string, unsigned> by_value;
+    std::vector<std::string const *>          strings;
+    std::vector<uint32_t>                     offsets;
+    std::vector<std::pair<unsigned, core_addr_t *>> bindings;
+    std::deque<frag_offset_t>                 label_offsets;
+};
+
+}
+
+namespace kas::core::opc
+{
+    // string in pool. Labels at location are bound to pool
+    // NB: size is {0, length} until placement is chosen (see above)
+    struct opc_merge_ref : opcode
+    {
+        OPC_INDEX();
+        const char *name() const override { return "MERGE"; }
+
+        // NB: string held until `insn_inserter` chooses pool (see `place`)
+        void proc_args(data_t& data, std::string const& str)
+        {
+            pending_str = str;
+            data.fixed.fixed = {};
+            data.size        = op_size_t(0, str.size() + 1);
+        }
+
+        // add string from `proc_args` to pool for section. return reference
+        static unsigned place(core_section const& s)
+        {
+            auto pool  = core_merge_strings::get(s);
+            auto index = core_merge_strings::get(pool).add(pending_str);
+            refs().push_back({ pool, index });
+            return refs().size();
+        }
+
+        // string placed in section which never moves strings
+        static bool in_place(unsigned ref)
+        {
+            return core_merge_strings::get(refs()[ref - 1].pool).in_place;
+        }
+
+        // bind address to string from most recent `place`
+        static void bind(core_addr_t& addr)
+        {
+            auto& r = refs().back();
+            core_merge_strings::get(r.pool).bind(r.index, addr);
+        }
+
+        op_size_t calc_size(data_t& data, core_fits const& fits) const override
+        {
+            auto& r    = refs()[data.fixed.fixed - 1];
+            auto& pool = core_merge_strings::get(r.pool);
+            data.size  = pool.in_place ? pool[r.index].size() : 0;
+            return data.size;
+        }
+
+        void fmt(data_t const& data, std::ostream& os) const override
+        {
+            // NB: not placed when formatted before insertion
+            if (!data.fixed.fixed)
+            {
+                os << '"' << pending_str << '"';
+                return;
+            }
+            auto& r    = refs()[data.fixed.fixed - 1];
+            auto& pool = core_merge_strings::get(r.pool);
+            auto& str  = pool[r.index];
+            os << pool.section.name() << ", \"" << str.substr(0, str.size() - 1) << '"';
+        }
+
+        // string not pooled: emit in place
+        void emit(data_t const& data, core_emit& base, core_expr_dot const *dot_p) const override
+        {
+            auto& r    = refs()[data.fixed.fixed - 1];
+            auto& str  = core_merge_strings::get(r.pool)[r.index];
+            if (data.size())
+                base << emit_data(sizeof(char), str.size()) << str.data();
+        }
+
+    private:
+        struct ref_t
+        {
+            unsigned pool;
+            unsigned index;
+        };
+
+        static std::deque<ref_t>& refs()
+        {
+            static std::deque<ref_t> refs_;
+            return refs_;
+        }
+
+        static void clear()
+        {
+            refs().clear();
+        }
+
+        static inline std::string pending_str;
+        static inline kas_clear _c{clear};
+    };
+
+    // single chunk of pool data: pool number, offset, count
+    struct opc_merge_data : opcode
+    {
+        OPC_INDEX();
+        const char *name() const override { return "MERGE_DATA"; }
+
+        void operator()(data_t& data, uint32_t pool, uint32_t offset, uint32_t count) const
+        {
+            data.fixed.fixed = pool;
+            data.size        = count;
+            auto& di = data.di();
+            *di++ = offset;
+        }
+
+        void fmt(data_t const& data, std::ostream& os) const override
+        {
+            auto& pool = core_merge_strings::get(data.fixed.fixed);
+            os << pool.section.name() << ", " << *data.iter() << ", " << data.size();
+        }
+
+        void emit(data_t const& data, core_emit& base, core_expr_dot const *dot_p) const override
+        {
+            auto& pool   = core_merge_strings::get(data.fixed.fixed);
+            auto  offset = *data.iter()->get_fixed_p();
+            base << emit_data(sizeof(char), data.size()) << pool.data.data() + offset;
+        }
+    };
+}
+
+#endif
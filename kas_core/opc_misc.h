@@ -5,6 +5,8 @@
 #include "core_symbol.h"
 #include "core_section.h"
 
+#include <algorithm>
+
 namespace kas::core::opc
 {
     using expression::e_fixed_t;
@@ -135,6 +137,74 @@ namespace kas::core::opc
         }
     };
 
+    // fill: `count` copies of `width` byte `value` (eg: `.fill`, `.space`)
+    //
+    // Insns hold only {value, width}: data is generated at emit directly
+    // into the section buffer (no data for `SHT_NOBITS` sections). Insn
+    // sizes are `op_size_t`, so large fills are inserted as a series of
+    // `max_chunk` sized insns (as `opc_incbin`). The first chunk is
+    // generated by `proc_args`. `insn_inserter` inserts the rest.
+    struct opc_fill : opcode
+    {
+        OPC_INDEX();
+        const char *name() const override { return "FILL"; }
+
+        // largest fill held in single insn
+        static constexpr uint32_t max_chunk = 1 << 15;
+
+        // single chunk: value, width, count
+        void operator()(data_t& data, uint32_t value, uint8_t width, uint32_t count) const
+        {
+            data.fixed.fixed = value;
+            data.size        = count * width;
+            auto& di = data.di();
+            *di++ = width;
+        }
+
+        // next chunk of fill from `proc_args`
+        void operator()(data_t& data) const
+        {
+            auto n = std::min(pending.count, max_chunk / pending.width);
+            (*this)(data, pending.value, pending.width, n);
+            pending.count -= n;
+        }
+
+        // args are validated by front-end
+        void proc_args(data_t& data, uint32_t value, uint8_t width, uint32_t count)
+        {
+            pending = { value, width, count };
+            (*this)(data);
+        }
+
+        // test if chunks remain to be inserted
+        static bool more()
+        {
+            return pending.count;
+        }
+
+        void fmt(data_t const& data, std::ostream& os) const override
+        {
+            auto width = *data.iter()->get_fixed_p();
+            os << data.size() / width << ", " << width << ", " << data.fixed.fixed;
+        }
+
+        void emit(data_t const& data, core_emit& base, core_expr_dot const *dot_p) const override
+        {
+            auto width = *data.iter()->get_fixed_p();
+            base << emit_filler(data.size() / width, data.fixed.fixed, width);
+        }
+
+    private:
+        struct pending_t
+        {
+            uint32_t value;
+            uint8_t  width;
+            uint32_t count;
+        };
+
+        static inline pending_t pending;
+    };
+
     // XXX need to split BSD & generic
     struct opc_skip  : opcode
     {
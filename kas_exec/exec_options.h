@@ -8,6 +8,8 @@ namespace kas::exec
 
 struct {
     const char *obj_file;
+    const char *cache_dir;
+    const char *trace_file;
     int  kas_debug;
     bool statistics;
     bool suppress_warnings;
@@ -24,8 +26,12 @@ void add_exec_options(kas::options::po_defns& defns)
                                         , o.kas_debug)
         ("-o,:OBJFILE,a.out"      , "name the object-file output OBJFILE"
                                         , o.obj_file)
+        ("--cache-dir,:DIR"       , "reuse previously assembled output cached in DIR"
+                                        , o.cache_dir)
         ("--statistics"           , "print various measured statistics from execution"
                                         , o.statistics)
+        ("--trace-file,:FILE"     , "write Chrome trace-event JSON timeline to FILE"
+                                        , o.trace_file)
         ("-W,--no-warn"           , "suppress warnings"
                                         , o.suppress_warnings)
         ("--warn,=0,0"            , "don't suppress warnings"
@@ -0,0 +1,158 @@
+#ifndef KAS_EXEC_KAS_CACHE_H
+#define KAS_EXEC_KAS_CACHE_H
+
+// kas_cache: content-addressed cache of assembler output
+//
+// CI systems frequently re-assemble identical generated sources. The
+// `kas_cache` allows those runs to copy a previously generated object
+// and listing instead of parsing, relaxing and emitting again.
+//
+// The cache key is a hash of every input which can change the output:
+//
+//  1. the source bytes
+//  2. the command line options (excluding output file names)
+//  3. the configured `kbfd` target (`KAS_KBFD_TARGET`)
+//  4. the assembler build id
+//
+// Files read during assembly (eg: `.include`) aren't part of the key, so
+// runs which reference them are not stored.
+//
+// Cache entries are stored as `<key>.o` and `<key>.lst` in a local
+// directory. On a hit, entries are copied to the requested outputs. (Not
+// hard-linked: an output edited in place would then corrupt the entry.)
+// New entries are written to a temporary name & renamed into place, so
+// concurrent assemblers sharing a cache directory never see partial files.
+
+#include <boost/filesystem.hpp>
+
+#include <cstdint>
+#include <string>
+#include <sstream>
+#include <iomanip>
+#include <ostream>
+
+// build id: override from Makefile to identify assembler version
+#ifndef KAS_BUILD_ID
+#define KAS_BUILD_ID __DATE__ " " __TIME__
+#endif
+
+namespace kas::exec
+{
+namespace fs = boost::filesystem;
+
+struct kas_cache
+{
+    using hash_t = uint64_t;
+
+    // FNV-1a (64-bit) parameters
+    static constexpr hash_t FNV_OFFSET = 0xcbf29ce484222325ULL;
+    static constexpr hash_t FNV_PRIME  = 0x100000001b3ULL;
+
+    kas_cache(const char *dir) : dir(dir ? dir : "") {}
+
+    // cache is enabled if directory specified
+    operator bool() const { return !dir.empty(); }
+
+    // accumulate key data
+    void add_key(void const *p, std::size_t n)
+    {
+        auto cp = static_cast<unsigned char const *>(p);
+        for (auto end = cp + n; cp != end; ++cp)
+        {
+            hash ^= *cp;
+            hash *= FNV_PRIME;
+        }
+        key_size += n;
+    }
+
+    void add_key(std::string const& s)
+    {
+        // include terminating NUL so ("ab", "c") != ("a", "bc")
+        add_key(s.c_str(), s.size() + 1);
+    }
+
+    // cache entry name: hash & total key length
+    std::string key() const
+    {
+        std::ostringstream s;
+        s << std::hex << std::setfill('0') << std::setw(16) << hash;
+        s << '-' << key_size;
+        return s.str();
+    }
+
+    // lookup entry: if found, place in `obj` and `lst` paths
+    bool fetch(fs::path const& obj, fs::path const& lst) const
+    {
+        auto base = dir / key();
+        auto c_obj = fs::path(base).concat(".o");
+        auto c_lst = fs::path(base).concat(".lst");
+
+        boost::system::error_code ec;
+        if (!fs::exists(c_obj, ec) || !fs::exists(c_lst, ec))
+        {
+            ++misses;
+            return false;
+        }
+
+        if (!copy_one(c_obj, obj) || !copy_one(c_lst, lst))
+        {
+            ++misses;
+            return false;
+        }
+
+        ++hits;
+        return true;
+    }
+
+    // save generated outputs in cache
+    void store(fs::path const& obj, fs::path const& lst) const
+    {
+        boost::system::error_code ec;
+        fs::create_directories(dir, ec);
+
+        auto base = dir / key();
+        if (store_one(obj, fs::path(base).concat(".o")) &&
+            store_one(lst, fs::path(base).concat(".lst")))
+            ++stores;
+    }
+
+    template <typename OS>
+    static void print_stats(OS& os)
+    {
+        os << "cache: hits = " << hits;
+        os << ", misses = " << misses;
+        os << ", stores = " << stores << std::endl;
+    }
+
+private:
+    static bool copy_one(fs::path const& from, fs::path const& to)
+    {
+        boost::system::error_code ec;
+        fs::copy_file(from, to, fs::copy_options::overwrite_existing, ec);
+        return !ec;
+    }
+
+    // copy to unique temporary, then atomic rename
+    static bool store_one(fs::path const& from, fs::path const& to)
+    {
+        boost::system::error_code ec;
+        auto tmp = fs::path(to).concat(fs::unique_path(".%%%%-%%%%").native());
+        fs::copy_file(from, tmp, fs::copy_options::overwrite_existing, ec);
+        if (!ec)
+            fs::rename(tmp, to, ec);
+        if (!ec)
+            return true;
+        fs::remove(tmp, ec);
+        return false;
+    }
+
+    fs::path    dir;
+    hash_t      hash     { FNV_OFFSET };
+    std::size_t key_size {};
+
+    static inline unsigned hits, misses, stores;
+};
+
+}
+
+#endif
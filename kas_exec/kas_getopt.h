@@ -4,6 +4,7 @@
 // handle assembler program options
 
 #include "machine_parsers.h"        // configured headers
+#include "bsd/bsd_options.h"        // assume BSD pseudos
 #include "exec_options.h"
 #include "kas_core/core_options.h"  // core modules
 #include "program_options/po_defn_impl.h"
@@ -1,10 +1,24 @@
-
 #include "kas_getopt.h"
 #include "exec_options.h"
+#include "kas_cache.h"
+
+#include "parser/parser_obj.h"
+#include "parser/parser_include.h"
 #include "kas_core/assemble.h"
+#include "kas_core/emit_kbfd.h"
 #include "kas_core/emit_listing.h"
-#include "kbfd/kbfd_emit.h"
+#include "kas_core/core_stats.h"
+#include "kas_core/core_trace.h"
+#include "kas_core/opc_incbin.h"
+#include "dwarf/dwarf_impl.h"
+#include "machine_out.h"
+
+#include "kbfd/kbfd.h"
+
 #include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
 #include <boost/filesystem.hpp>
 
 using namespace kas;
@@ -12,6 +26,10 @@ namespace fs = boost::filesystem;
 
 int main(int argc, char **argv)
 {
+    // save copy of command line for cache key
+    // NB: `get_options` modifies option strings in place (eg: `--opt=value`)
+    std::vector<std::string> cmd_line(argv, argv + argc);
+
     argv = exec::get_options(argc, argv);
 
     // XXX support: 1 source file
@@ -46,7 +64,7 @@ int main(int argc, char **argv)
     dbg_file += ".debug";
 
     std::cout << "input : " << src_file << std::endl;
-    std::cout << "output: " << obj_file << std::endl; 
+    std::cout << "output: " << obj_file << std::endl;
     std::cout << "list  : " << lst_file << std::endl;
 
     // delete output files
@@ -55,36 +73,101 @@ int main(int argc, char **argv)
     fs::remove(dbg_file);
 
     // read source to buffer
+    // NB: parser iterates over `std::string`
     std::ifstream src_stream(src_file.native(), std::ios::binary | std::ios::ate);
     auto size = src_stream.tellg();
     src_stream.seekg(0, std::ios::beg);
 
-    std::vector<char> src_data(size);;
+    std::string src_data(size, '\0');
     std::noskipws(src_stream);
 
     src_stream.read(src_data.data(), size);
-    
-    // 
+
+    // key cache on source, options, target & assembler
+    // NB: omit output file names & positional arguments
+    exec::kas_cache cache(exec::exec_options.cache_dir);
+    if (cache)
+    {
+        auto n_opts = cmd_line.size() - argc;
+        for (unsigned i = 1; i < n_opts; ++i)
+        {
+            auto& arg = cmd_line[i];
+            if (arg == "-o")
+                ++i;
+            else if (arg.compare(0, 2, "-o"))
+                cache.add_key(arg);
+        }
+        cache.add_key(KAS_KBFD_TARGET());
+        cache.add_key(KAS_BUILD_ID);
+        cache.add_key(src_data);
+
+        if (cache.fetch(obj_file, lst_file))
+        {
+            std::cout << "cache : " << cache.key() << " (hit)" << std::endl;
+            if (exec::exec_options.statistics)
+            {
+                core::core_stats::print(std::cout);
+                cache.print_stats(std::cout);
+            }
+            return 0;
+        }
+    }
+
+    // open performance trace if requested
+    std::ofstream trace_out;
+    if (auto p = exec::exec_options.trace_file)
+    {
+        trace_out.open(p);
+        if (!trace_out) {
+            std::cout << "as: can't open trace file: " << p << std::endl;
+            exit (1);
+        }
+        core::core_trace::open(trace_out);
+    }
+
+    //
     std::ofstream parse_out(dbg_file.native());
     std::cout  << "\nparse begins: " << src_file << std::endl;
-    kas::core::kas_assemble obj;
-
-    obj.assemble(src_data.begin(), src_data.end(), &parse_out);
-
-#if 1
-    std::ofstream list_stream(lst_file.native(), std::ios::binary);
-    kas::core::emit_listing<parser::iterator_type> listing(list_stream);
-    obj.emit(listing);
-    kas::core::core_symbol::dump(list_stream);
-#endif
-#if 1
-    kas::kbfd::elf_emit elf_obj(ELFCLASS32, ELFDATA2MSB, EM_68K); 
-    obj.emit(elf_obj);
-
-    std::ofstream elf_out(obj_file.native(), std::ios_base::binary);
-    elf_obj.write(elf_out);
-#endif
-    
+
+    // create source object
+    parser::parser_src src;
+    src.push(src_data.cbegin(), src_data.cend(), src_file.c_str());
+
+    // need object format before assembling
+    auto& obj_fmt = *kbfd::get_obj_format(KAS_KBFD_TARGET());
+    kbfd::kbfd_object kbfd_obj(obj_fmt);
+
+    // create assembler object & assemble source
+    core::kas_assemble obj(kbfd_obj);
+    obj.assemble(src, &parse_out);
+
+    // generate object file
+    {
+        std::ofstream elf_out(obj_file.native(), std::ios_base::binary);
+        core::emit_kbfd binary(kbfd_obj, elf_out);
+        obj.emit(binary, "emit_object");
+    }
+
+    // generate listing
+    {
+        std::ofstream list_stream(lst_file.native(), std::ios::binary);
+        core::emit_listing<parser::iterator_type> listing(kbfd_obj, list_stream);
+        obj.emit(listing, "emit_listing");
+    }
+
+    core::core_trace::close();
+
+    // NB: `.include` & `.incbin` file contents aren't part of cache key
+    if (cache && !core::core_incbin::size() && !parser::parser_include::size())
+        cache.store(obj_file, lst_file);
+
+    if (exec::exec_options.statistics)
+    {
+        core::core_stats::print(std::cout);
+        if (cache)
+            cache.print_stats(std::cout);
+    }
+
     return 0;
 }
 
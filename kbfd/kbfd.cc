@@ -14,6 +14,7 @@
 #include "kbfd_target_format_impl.h"
 #include "kbfd_section_impl.h"
 #include "kbfd_section_sym_impl.h"
+#include "kbfd_compress_impl.h"
 
 // include "format" _impl files
 #include "kbfd_format_elf_write.h"
@@ -0,0 +1,56 @@
+#ifndef KBFD_KBFD_COMPRESS_H
+#define KBFD_KBFD_COMPRESS_H
+
+// kbfd_compress: compress ELF debug sections (`SHF_COMPRESSED`)
+//
+// When enabled (`--compress-debug-sections`), the data of each `.debug_*`
+// section is replaced by a compression header (`Elf32_Chdr` or
+// `Elf64_Chdr` in target format) followed by a zlib stream.
+//
+// Compression is performed after all section data is generated & before
+// file offsets are calculated. Each section is compressed by a separate
+// task. Section data is passed to zlib in `max_chunk` pieces. Sections
+// which don't shrink are written uncompressed.
+//
+// NB: `zlib-gnu` (`.zdebug_*` sections) is obsolete: treated as `zlib`
+
+#include "kbfd_object.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace kbfd
+{
+
+struct kbfd_compress
+{
+    // `--compress-debug-sections` values (see `core_options.h`)
+    enum { COMPRESS_NONE, COMPRESS_ZLIB, COMPRESS_ZLIB_GNU, COMPRESS_ZLIB_GABI };
+
+    // NB: static member (not `elf_options`) so all translation units share
+    static inline uint8_t mode;
+
+    // largest piece of section data passed to zlib
+    static constexpr std::size_t max_chunk = 1 << 16;
+
+    // compress debug sections in object
+    static void compress(kbfd_object& obj);
+
+private:
+    static bool is_debug(kbfd_section const& s);
+
+    static bool is_elf64(kbfd_object const& obj)
+    {
+        return obj.e_hdr.e_ident[EI_CLASS] == ELFCLASS64;
+    }
+
+    // generate compression header in target format
+    static std::vector<char> gen_chdr(kbfd_object const& obj, kbfd_section const& s);
+
+    // compress data following `hdr_size` reserved bytes
+    static std::vector<char> deflate(const char *p, std::size_t n, std::size_t hdr_size);
+};
+
+}
+
+#endif
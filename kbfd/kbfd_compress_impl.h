@@ -0,0 +1,133 @@
+#ifndef KBFD_KBFD_COMPRESS_IMPL_H
+#define KBFD_KBFD_COMPRESS_IMPL_H
+
+//
+// implement non-trivial methods
+//
+
+#include "kbfd_compress.h"
+#include "kbfd_section.h"
+#include "kbfd_endian.h"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <cstring>
+#include <future>
+
+namespace kbfd
+{
+
+void kbfd_compress::compress(kbfd_object& obj)
+{
+    if (mode == COMPRESS_NONE)
+        return;
+
+    struct pending_t
+    {
+        kbfd_section *s;
+        std::vector<char> chdr;
+        std::future<std::vector<char>> result;
+    };
+
+    // NB: `swap_endian` uses static storage: generate headers here, not in tasks
+    std::vector<pending_t> pending;
+    for (auto p : obj.section_ptrs)
+    {
+        if (!is_debug(*p))
+            continue;
+        auto chdr = gen_chdr(obj, *p);
+        auto size = chdr.size();
+        pending.push_back({ p, std::move(chdr)
+                          , std::async(std::launch::async, deflate
+                                     , p->begin(), p->position(), size) });
+    }
+
+    for (auto& [s, chdr, result] : pending)
+    {
+        auto data = result.get();
+        if (data.empty() || data.size() >= s->position())
+            continue;
+
+        std::memcpy(data.data(), chdr.data(), chdr.size());
+        s->replace(std::move(data));
+        s->s_header.sh_flags    |= SHF_COMPRESSED;
+        s->s_header.sh_addralign = is_elf64(obj) ? 8 : 4;
+    }
+}
+
+bool kbfd_compress::is_debug(kbfd_section const& s)
+{
+    static constexpr char prefix[] = ".debug_";
+    static constexpr auto prefix_len = sizeof(prefix) - 1;
+
+    if (s.s_header.sh_type == SHT_NOBITS || !s.position())
+        return false;
+    if (s.s_header.sh_flags & (SHF_ALLOC | SHF_COMPRESSED))
+        return false;
+    return !s.name.compare(0, prefix_len, prefix);
+}
+
+std::vector<char> kbfd_compress::gen_chdr(kbfd_object const& obj, kbfd_section const& s)
+{
+    std::vector<char> chdr;
+    auto put = [&](int64_t value, uint8_t width)
+        {
+            auto p = static_cast<const char *>(obj.swap(value, width));
+            chdr.insert(chdr.end(), p, p + width);
+        };
+
+    // NB: `ch_addralign` is alignment of uncompressed data
+    auto align = std::max<Elf64_Xword>(s.s_header.sh_addralign, 1);
+    if (is_elf64(obj))
+    {
+        put(ELFCOMPRESS_ZLIB, 4);
+        put(0, 4);                  // ch_reserved
+        put(s.position(), 8);
+        put(align, 8);
+    }
+    else
+    {
+        put(ELFCOMPRESS_ZLIB, 4);
+        put(s.position(), 4);
+        put(align, 4);
+    }
+    return chdr;
+}
+
+std::vector<char> kbfd_compress::deflate(const char *p, std::size_t n, std::size_t hdr_size)
+{
+    z_stream z {};
+    if (deflateInit(&z, Z_DEFAULT_COMPRESSION) != Z_OK)
+        return {};
+
+    // allocate worst case: single `deflate` call completes stream
+    std::vector<char> out(hdr_size + deflateBound(&z, n));
+    z.next_out  = reinterpret_cast<Bytef *>(out.data() + hdr_size);
+    z.avail_out = out.size() - hdr_size;
+
+    int flush;
+    do
+    {
+        auto chunk = std::min(n, max_chunk);
+        z.next_in  = reinterpret_cast<Bytef *>(const_cast<char *>(p));
+        z.avail_in = chunk;
+        p += chunk;
+        n -= chunk;
+
+        flush = n ? Z_NO_FLUSH : Z_FINISH;
+        if (::deflate(&z, flush) == Z_STREAM_ERROR)
+        {
+            deflateEnd(&z);
+            return {};
+        }
+    } while (flush != Z_FINISH);
+
+    out.resize(hdr_size + z.total_out);
+    deflateEnd(&z);
+    return out;
+}
+
+}
+
+#endif
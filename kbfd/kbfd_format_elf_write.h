@@ -5,6 +5,7 @@
 #include "kbfd_section_data.h"
 #include "kbfd_convert.h"
 #include "kbfd_section_sym.h"
+#include "kbfd_compress.h"
 
 namespace kbfd
 {
@@ -27,17 +28,25 @@ void kbfd_format_elf<ENDIAN, HEADERS, Ts...>::
     auto& sh_string_p  = obj.sh_string_p;
     auto& section_ptrs = obj.section_ptrs;
 
+    // compress debug sections (as required)
+    kbfd_compress::compress(obj);
+
     // create section_name section, if needed
     if (!sh_string_p)
         sh_string_p = new ks_string(obj, ".shstrtab");
 
     // initialize section names (as required)
+    // NB: `put` returns key. Convert to offset after layout
     for (auto& p : section_ptrs)
     {
         if (!p->s_header.sh_name)
             p->s_header.sh_name = sh_string_p->put(p->name);
     };
 
+    sh_string_p->layout();
+    for (auto& p : section_ptrs)
+        p->s_header.sh_name = sh_string_p->offset(p->s_header.sh_name);
+
     
     // initialize ELF header section indexes (+1 for initial zero section)
     e_hdr.e_shnum      = section_ptrs.size() + 1;
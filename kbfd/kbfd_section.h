@@ -36,8 +36,14 @@ struct kbfd_section
         put(s.first, s.second);
     }
 
+    // append `count` copies of `width` byte pattern
+    void fill(void const *p, std::size_t width, std::size_t count);
+
     // set size in bytes
     void set_size(Elf64_Xword new_size);
+
+    // replace section data (eg: compressed). Data is complete
+    void replace(std::vector<char>&& new_data);
     
     // size in bytes
     std::size_t size() const
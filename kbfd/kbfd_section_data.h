@@ -96,6 +96,12 @@ struct ks_data : kbfd_section
             this->put(object.swap(p, width), width);
     }
 
+    // put `count` copies of single value into section (with byte-swapping)
+    void put_fill(int64_t data, uint8_t width, unsigned count)
+    {
+        this->fill(object.swap(data, width), width, count);
+    }
+
     // put raw data into buffer (no byte-swapping)
     void put_raw(void const *p, unsigned count)
     {
@@ -7,6 +7,9 @@
 
 #include "kbfd_section.h"
 
+#include <algorithm>
+#include <cstring>
+
 namespace kbfd
 {
 
@@ -76,6 +79,61 @@ void kbfd_section::put(void const *p, std::size_t n)
     data_p += n;
 }
 
+// append `count` copies of `width` byte pattern
+void kbfd_section::fill(void const *p, std::size_t width, std::size_t count)
+{
+    auto n = width * count;
+
+    // `SHT_NOBITS`: just accumulate offset
+    if (s_header.sh_type == SHT_NOBITS || !n)
+    {
+        data_p += n;
+        if (!data_base && data_endb < data_p)
+            data_endb = data_p;
+        return;
+    }
+
+    // make room for pattern
+    char *dest;
+    if (data_base)
+    {
+        if ((data_p + n) > data_endb)
+            throw section_error(*this, __FUNCTION__, "buffer overflow");
+        dest = data_p;
+    }
+    else
+    {
+        data.resize(data.size() + n);
+        dest = data.data() + position();
+        if (data_endb < data_p + n)
+            data_endb = data_p + n;
+    }
+
+    // uniform pattern (eg: zero) is `memset`. Otherwise replicate by doubling
+    auto pattern = static_cast<const char *>(p);
+    if (std::all_of(pattern, pattern + width, [c = *pattern](char b) { return b == c; }))
+        std::memset(dest, *pattern, n);
+    else
+    {
+        std::memcpy(dest, pattern, width);
+        for (std::size_t done = width; done < n; done *= 2)
+            std::memcpy(dest + done, dest, std::min(done, n - done));
+    }
+
+    data_p += n;
+}
+
+void kbfd_section::replace(std::vector<char>&& new_data)
+{
+    if (s_header.sh_type == SHT_NOBITS)
+        throw section_error(*this, __FUNCTION__, "no data to replace");
+
+    // treat as pre-allocated buffer which is full
+    data      = std::move(new_data);
+    data_base = data.data();
+    data_p    = data_endb = data_base + data.size();
+}
+
 void kbfd_section::set_size(Elf64_Xword new_size)
 {
     std::cout << "kbfd_section::set_size: " << name << " = " << new_size << std::endl;
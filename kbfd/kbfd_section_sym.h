@@ -4,10 +4,21 @@
 
 #include "kbfd_section.h"
 
+#include <deque>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
 namespace kbfd
 {
 
 // create a string section
+//
+// Strings are deduplicated as added & laid out when object is written.
+// `put` returns a key. After `layout`, `offset` converts key to offset.
+//
+// Layout sorts strings by reversed value so a string which is the tail
+// of another (eg: `.text` & `.rel.text`) shares the longer copy.
 struct ks_string : kbfd_section
 {
     ks_string(kbfd_object& obj, std::string name)
@@ -19,19 +30,53 @@ struct ks_string : kbfd_section
     // delete raw access
     void put(void const *, std::size_t) = delete;
     
-    auto put(std::string const& s)
+    // add string: return key. empty string is key (& offset) zero
+    Elf64_Word put(std::string_view s)
     {
-        auto position = kbfd_section::position();
-        kbfd_section::put(s.data(), s.size() + 1);
-        return position;
+        if (s.empty())
+            return 0;
+
+        auto it = index.find(s);
+        if (it != index.end())
+            return it->second;
+
+        // NB: `deque` storage is stable: index holds views
+        auto& name = names.emplace_back(s);
+        Elf64_Word key = names.size();
+        index.emplace(name, key);
+
+        // strings added following layout are appended
+        if (laid_out)
+        {
+            offsets.push_back(kbfd_section::position());
+            kbfd_section::put(name.c_str(), name.size() + 1);
+        }
+        return key;
     }
 
-    auto put(const char *p)
+    auto put(std::string const& s) { return put(std::string_view(s)); }
+    auto put(const char *p)        { return put(std::string_view(p)); }
+
+    // string from key
+    const char *str(Elf64_Word key) const
     {
-        auto position = kbfd_section::position();
-        kbfd_section::put(p, std::strlen(p) + 1);
-        return position;
+        return key ? names[key - 1].c_str() : "";
     }
+
+    // offset from key. valid following `layout`
+    Elf64_Word offset(Elf64_Word key) const
+    {
+        return key ? offsets[key - 1] : 0;
+    }
+
+    // generate section data
+    void layout();
+
+private:
+    std::deque<std::string> names;
+    std::unordered_map<std::string_view, Elf64_Word> index;
+    std::vector<Elf64_Word> offsets;
+    bool laid_out {};
 };
 
 // create a symbol section
@@ -67,7 +112,7 @@ struct ks_symbol : kbfd_section
 
     const char *sym_name(kbfd_sym const& sym) const
     {
-        return sym_string.begin() + sym.st_name;
+        return sym_string.str(sym.st_name);
     }
 
     const char *sym_name(Elf64_Word index) const
@@ -7,10 +7,29 @@
 
 #include "kbfd_section_sym.h"
 #include "kbfd_convert.h"
+#include "kbfd_string_layout.h"
 
 namespace kbfd
 {
 
+// strings which are tails of a string share it (see `kbfd_string_layout.h`)
+void ks_string::layout()
+{
+    if (laid_out)
+        return;
+    laid_out = true;
+
+    // strings follow initial NUL
+    offsets = tail_share_layout<Elf64_Word>(names.size()
+                    , [this](auto n) { return std::string_view(names[n]); }
+                    , [this](auto n)
+                        {
+                            Elf64_Word offset = kbfd_section::position();
+                            kbfd_section::put(names[n].c_str(), names[n].size() + 1);
+                            return offset;
+                        });
+}
+
 // actual initializer
 ks_symbol::ks_symbol(kbfd_object& obj, std::string tab_name, std::string str_name)
     : sym_string (obj, str_name)
@@ -46,13 +65,19 @@ Elf64_Word ks_symbol::add(kbfd_sym const& new_sym, std::string const& name)
 // convert "host" object to "target" object
 void ks_symbol::do_gen_target(kbfd_object& obj)
 {
+    // symbol names are offsets in target table
+    sym_string.layout();
+
     // XXX if passthru just modify pointers...
     auto cnt = host_table.size();           // get entry count...
     set_size(cnt * s_header.sh_entsize);    // ... and allocate memory
     
     // convert host -> target
-    for (auto& s : host_table)
+    for (auto s : host_table)
+    {
+        s.st_name = sym_string.offset(s.st_name);
         kbfd_section::put(obj.cvt(s));
+    }
 }
 
 }
@@ -0,0 +1,60 @@
+#ifndef KBFD_KBFD_STRING_LAYOUT_H
+#define KBFD_KBFD_STRING_LAYOUT_H
+
+// lay out a table of strings, sharing tails
+//
+// Strings are sorted by reversed value, so a string which is the tail of
+// another (eg: `.text` & `.rel.text`) immediately follows it & is located
+// in the longer copy instead of being stored.
+//
+// `get(n)` returns string `n` as `std::string_view`. `put(n)` stores string
+// `n` & returns its offset. Return offset of each of `count` strings.
+//
+// Used for `.strtab` (`ks_string`) & by the assembler for strings in
+// `SHF_MERGE | SHF_STRINGS` sections.
+
+#include <algorithm>
+#include <numeric>
+#include <string_view>
+#include <vector>
+
+namespace kbfd
+{
+
+template <typename OFFSET_T, typename GET, typename PUT>
+std::vector<OFFSET_T> tail_share_layout(std::size_t count, GET get, PUT put)
+{
+    std::vector<std::size_t> order(count);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&get](auto a, auto b)
+        {
+            std::string_view x = get(a);
+            std::string_view y = get(b);
+            return std::lexicographical_compare(y.rbegin(), y.rend()
+                                              , x.rbegin(), x.rend());
+        });
+
+    std::vector<OFFSET_T> offsets(count);
+    std::string_view prev;
+    std::size_t prev_idx {};
+    bool have_prev {};
+    for (auto idx : order)
+    {
+        std::string_view s = get(idx);
+        if (have_prev && prev.size() >= s.size()
+                      && std::equal(s.rbegin(), s.rend(), prev.rbegin()))
+            offsets[idx] = offsets[prev_idx] + prev.size() - s.size();
+        else
+        {
+            offsets[idx] = put(idx);
+            prev      = s;
+            prev_idx  = idx;
+            have_prev = true;
+        }
+    }
+    return offsets;
+}
+
+}
+
+#endif
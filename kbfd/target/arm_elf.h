@@ -52,7 +52,7 @@ static constexpr kbfd_target_reloc arm_elf_relocs[] =
   // NB: G1/G2 flags are used to differentiate between _CALL & _JUMP24
   , {  28, "R_ARM_CALL"     , ARM_REL_A32JUMP(), 32, 1, T_ARM, ARM_G1 }
   , {  29, "R_ARM_JUMP24"   , ARM_REL_A32JUMP(), 32, 1, T_ARM, ARM_G2 }
-  , {  30, "R_ARM_THM_JUMP24", ARM_REL_T32JUMP24()    , 32, 0, T_T32}
+  , {  30, "R_ARM_THM_JUMP24", ARM_REL_T32JUMP24()    , 32, 1, T_T32, ARM_G2 }
   , {  31, "R_ARM_BASE_ABS" , K_REL_ADD()      , 32, 0, SB_REL }
   , {  35, "R_ARM_LDR_SBREL_11_0_NC" , K_REL_NONE(), 32, 0, T_ARM, T_DEPR }
   , {  36, "R_ARM_LDR_SBREL_19_12_NC", K_REL_NONE(), 32, 0, T_ARM, T_DEPR }
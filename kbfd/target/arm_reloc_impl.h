@@ -246,6 +246,7 @@ struct arm_rel_jump8 : k_rel_add_t
                      {};
 
 struct arm_rel_jump11 : k_rel_add_t
+                      , reloc_op_shift<1>
                       , reloc_op_s_subfield<11> 
                       {};
 
@@ -242,6 +242,22 @@ public:
         return handler->get_file();
     }
 
+    // text & line index of current handler
+    auto first() const
+    {
+        return handler->first();
+    }
+
+    auto last() const
+    {
+        return handler->last();
+    }
+
+    auto line_index() const
+    {
+        return handler->line_index();
+    }
+
     // stream error message (see error_reporting.h for formats)
     // XXX these messages need to be routed thru `kas_diag`
     template <typename...Ts>
@@ -10,6 +10,7 @@
 // - Remove "err_out" from ctor; make ostream an operator() arg
 // - Expose "file" via method
 // - Add `position_max` method to expose size of pos_cache
+// - Replace line number scan with (shared) `x3_line_index`
 
 // Insure that x3 headers that directly include x3 header get the
 // modified class:
@@ -32,7 +33,10 @@
 
 #include <boost/locale/encoding_utf.hpp>
 #include <boost/spirit/home/x3/support/ast/position_tagged.hpp>
+#include <algorithm>
+#include <memory>
 #include <ostream>
+#include <vector>
 
 // Clang-style error handling utilities
 
@@ -80,18 +84,64 @@ void kas_diag<REF>::print(OS& os) const
 }
 
 
+// line index: offsets where line numbers advance. Built on first use.
+// NB: shared by all handlers over same text (eg: file included many times)
+//
+// Text copied from another source (eg: macro expansion) reports lines of
+// the original: `base` lines precede the copy. If the copy is repeated
+// (eg: `.irp`), `period` is number of lines in each repetition.
+struct x3_line_index
+{
+    x3_line_index(std::size_t base = 0, std::size_t period = 0)
+        : base(base), period(period) {}
+
+    template <typename Iterator>
+    std::size_t line(Iterator first, Iterator last, Iterator pos)
+    {
+        if (!init)
+        {
+            init = true;
+            std::size_t offset {};
+            typename std::iterator_traits<Iterator>::value_type prev { 0 };
+            for (auto it = first; it != last; ++it, ++offset)
+            {
+                auto c = *it;
+                if ((c == '\n' && prev != '\r') || (c == '\r' && prev != '\n'))
+                    breaks.push_back(offset);
+                prev = c;
+            }
+        }
+
+        // line number is one more than breaks before `pos`
+        std::size_t offset = std::distance(first, pos);
+        std::size_t n = std::lower_bound(breaks.begin(), breaks.end(), offset) - breaks.begin();
+        if (period)
+            n %= period;
+        return base + 1 + n;
+    }
+
+private:
+    std::vector<std::size_t> breaks;
+    std::size_t base;
+    std::size_t period;
+    bool init {};
+};
+
 template <typename Iterator>
 class x3_error_handler
 {
 public:
     typedef Iterator iterator_type;
+    using line_index_p = std::shared_ptr<x3_line_index>;
 
     x3_error_handler(
-        Iterator first, Iterator last, std::string file = "", int tabs = 4)
+        Iterator first, Iterator last, std::string file = ""
+        , line_index_p lines = {}, int tabs = 4)
       : file(file)
       , tabs(tabs)
       , tab_position(tabs)
-      , pos_cache(first, last) {}
+      , pos_cache(first, last)
+      , lines(lines ? lines : std::make_shared<x3_line_index>()) {}
 
     typedef void result_type;
 
@@ -189,6 +239,11 @@ public:
     {
         return file;
     }
+
+    auto line_index() const
+    {
+        return lines;
+    }
     
 private:
     auto position_max() const
@@ -218,6 +273,7 @@ private:
     int tabs;           // tab width
     mutable int tab_position;   // position within tab
     x3::position_cache<std::deque<Iterator>> pos_cache;
+    line_index_p lines;
 };
 
 template <typename Iterator>
@@ -317,25 +373,7 @@ inline Iterator x3_error_handler<Iterator>::get_line_start(Iterator first, Itera
 template <typename Iterator>
 std::size_t x3_error_handler<Iterator>::position(Iterator i) const
 {
-    std::size_t line { 1 };
-    typename std::iterator_traits<Iterator>::value_type prev { 0 };
-
-    for (Iterator pos = pos_cache.first(); pos != i; ++pos) {
-        auto c = *pos;
-        switch (c) {
-        case '\n':
-            if (prev != '\r') ++line;
-            break;
-        case '\r':
-            if (prev != '\n') ++line;
-            break;
-        default:
-            break;
-        }
-        prev = c;
-    }
-
-    return line;
+    return lines->line(pos_cache.first(), pos_cache.last(), i);
 }
 
 template <typename Iterator>
@@ -22,6 +22,15 @@ namespace kas
         // declare x3::on_success annotater
         struct annotate_on_success;
         using aos = annotate_on_success;
+
+        // get "fmt" index
+        using fmt_index = meta::find_index<detail::fmt_defn_names_l
+                                         , meta::_t<detail::fmt_defn_name<>>>;
+
+        // extract "per-fmt" index from "per-arch" type array of separators
+        // NB: also used by directives which scan text (eg: `.macro`)
+        using stmt_comment   = meta::at<meta::_t<detail::parser_comment  <>>, fmt_index>;
+        using stmt_separator = meta::at<meta::_t<detail::parser_separator<>>, fmt_index>;
     }
 
     // parser public interface
@@ -13,6 +13,7 @@
 
 #include "parser_src.h"
 #include "parser_def.h"
+#include "parser_scan.h"
 #include "token_parser.h"
 
 #include <boost/spirit/home/x3.hpp>
@@ -22,14 +23,6 @@ namespace kas::parser
 {
 namespace x3 = boost::spirit::x3;
 
-// get "fmt" index
-using fmt_index = meta::find_index<detail::fmt_defn_names_l
-                                 , meta::_t<detail::fmt_defn_name<>>>;
-
-// extract "per-fmt" index from "per-arch" type array of separators
-using stmt_comment   = meta::at<meta::_t<detail::parser_comment  <>>, fmt_index>;
-using stmt_separator = meta::at<meta::_t<detail::parser_separator<>>, fmt_index>;
-
 //////////////////////////////////////////////////////////////////////////
 //  Parser Support Methods
 //      * end-of-line
@@ -38,14 +31,12 @@ using stmt_separator = meta::at<meta::_t<detail::parser_separator<>>, fmt_index>
 //////////////////////////////////////////////////////////////////////////
 
 // parse to comment, separator, or end-of-line
+// NB: hand-written scanner. see `parser_scan.h`
 auto const stmt_eol = x3::rule<class _> {"stmt_eol"} =
-      ( x3::lit(stmt_comment{}()) >> 
-        x3::omit[*(x3::char_ - x3::eol)] >> 
-        -x3::eol
-      )
-    | x3::lit(stmt_separator{}())
-    | x3::eol
-    ;
+        scan_eol<stmt_comment, stmt_separator>;
+
+// absorb blank lines, comment lines, and empty statements
+auto const stmt_blank = scan_blank<stmt_comment, stmt_separator>;
 
 // absorb characters until EOL
 x3::rule<class _> skip_eol {"skip_eol"};
@@ -81,7 +72,7 @@ BOOST_SPIRIT_DEFINE(parse_insn);
 // NB: parse "statement" separately because X3 sees `variant` base
 // class in `stmt_t` & slices away `kas_position_tagged` base class.
 // Solution: have "statment" perform variant operaion & tag afterwords
-auto const stmt_def  = *stmt_eol > tagged_stmt;
+auto const stmt_def  = stmt_blank > tagged_stmt;
 
 // Parse an "invalid" instruction (invalid opcode, not mismatched args)
 // 
@@ -0,0 +1,130 @@
+#ifndef KAS_PARSER_PARSER_INCLUDE_H
+#define KAS_PARSER_PARSER_INCLUDE_H
+
+// parser_include: registry of files read by `.include`
+//
+// Each include file is read once per process, no matter how many times
+// it is included. The text & its line index are shared by every inclusion,
+// so large shared headers (eg: `.equ` definitions) are read & indexed once.
+//
+// File text is never released: `kas_loc` values (used for diagnostics &
+// listings after parsing completes) reference the text.
+//
+// Files are located by trying the name as given, then by prefixing
+// each directory in the `-I` search path.
+
+#include "parser_src.h"
+
+#include <boost/filesystem.hpp>
+
+#include <deque>
+#include <fstream>
+#include <list>
+#include <map>
+#include <memory>
+#include <string>
+
+namespace kas::parser
+{
+
+struct parser_include
+{
+    struct src_file
+    {
+        std::string path;
+        std::string text;
+        std::shared_ptr<x3_line_index> lines;
+    };
+
+    // `-I` search path
+    // NB: static member (not `bsd_options`) so all translation units share
+    static inline std::list<const char *> search_path;
+
+    // locate & read include file. return nullptr if not found
+    static src_file const *find(std::string const& name)
+    {
+        // lookup by name as given: search path doesn't change during run
+        auto& by_name = names()[name];
+        if (!by_name)
+            by_name = locate(name);
+        return by_name;
+    }
+
+    // parse `file` following current statement
+    static void push(src_file const& file)
+    {
+        parser_src::push(file.text.cbegin(), file.text.cend()
+                       , std::string(file.path), file.lines);
+    }
+
+    // number of files read
+    static auto size()
+    {
+        return files().size();
+    }
+
+private:
+    static src_file *locate(std::string const& name)
+    {
+        namespace fs = boost::filesystem;
+        boost::system::error_code ec;
+
+        fs::path path(name);
+        if (!fs::is_regular_file(path, ec) && path.is_relative())
+            for (auto dir : search_path)
+            {
+                path = fs::path(dir) / name;
+                if (fs::is_regular_file(path, ec))
+                    break;
+            }
+
+        if (!fs::is_regular_file(path, ec))
+            return {};
+
+        // same file may be found by different names
+        auto canonical = fs::canonical(path, ec).string();
+        auto& p = by_path()[canonical];
+        if (!p)
+            p = read(path.string());
+        return p;
+    }
+
+    static src_file *read(std::string const& path)
+    {
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        if (!in)
+            return {};
+
+        auto size = in.tellg();
+        in.seekg(0, std::ios::beg);
+
+        auto& file = files().emplace_back();
+        file.path  = path;
+        file.lines = std::make_shared<x3_line_index>();
+        file.text.resize(size);
+        in.read(file.text.data(), size);
+        return &file;
+    }
+
+    static std::deque<src_file>& files()
+    {
+        static std::deque<src_file> files_;
+        return files_;
+    }
+
+    static std::map<std::string, src_file *>& names()
+    {
+        static std::map<std::string, src_file *> names_;
+        return names_;
+    }
+
+    static std::map<std::string, src_file *>& by_path()
+    {
+        static std::map<std::string, src_file *> by_path_;
+        return by_path_;
+    }
+};
+
+}
+
+#endif
@@ -9,6 +9,7 @@
 #include "parser_src.h"
 
 #include <boost/filesystem.hpp>
+#include <optional>
 
 // development path:
 // - ctor for parser: container + fs::path
@@ -54,6 +55,10 @@ private:
                 if (src.iter() != src.last())
                     return true;
 
+                // repeated object (eg: `.rept`) starts over
+                if (src.restart())
+                    continue;
+
                 // pop current file & check again
                 src.pop();
             }
@@ -70,11 +75,12 @@ public:
     template <typename PARSER>
     kas_parser(PARSER const&, parser_src& src)
         : src(src)
-        , context{kas_context(*this, src.e_handler())}
+        , e_handler_p(&src.e_handler())
+        , context(std::in_place, *this, src.e_handler())
     {
         parse_fn = [](kas_parser& obj, Iter& iter, Iter const& end)
             {
-                return PARSER{}.parse(iter, end, obj.context(), skipper_t{}, obj.value);
+                return PARSER{}.parse(iter, end, (*obj.context)(), skipper_t{}, obj.value);
             };
     } 
 
@@ -83,7 +89,12 @@ public:
 
     auto parse(Iter& iter, Iter const& end)
     {
-        auto& ctx = x3::get<error_diag_tag>(context());
+        // tag locations using handler for current source (eg: `.include`)
+        if (e_handler_p != &src.e_handler())
+        {
+            e_handler_p = &src.e_handler();
+            context.emplace(*this, *e_handler_p);
+        }
         return parse_fn(*this, iter, end);
     }
 
@@ -95,7 +106,8 @@ public:
 private:
     parse_fn_t          parse_fn;
     parser_src&         src;
-    kas_context         context;
+    error_handler_type *e_handler_p;
+    std::optional<kas_context> context;
 };
 
 // extract statement from current input.
@@ -0,0 +1,128 @@
+#ifndef KAS_PARSER_PARSER_SCAN_H
+#define KAS_PARSER_PARSER_SCAN_H
+
+// parser_scan: hand-written scanners for statement boundaries
+//
+// Every statement begins by absorbing blank lines, comment lines & empty
+// statements, and ends by matching comment, separator, or end-of-line.
+// Expressed as X3 alternatives, each is a series of backtracking literal
+// matches (each with a skipper pre-skip) per character of comment text.
+// Compiler generated assembler has many comment & blank lines, so these
+// rules are a large share of parse work.
+//
+// `scan_eol` matches a single statement end. `scan_blank` absorbs any
+// number of empty statements. Both are X3 primitive parsers so they drop
+// into the grammar in place of the `stmt_eol` alternative.
+//
+// Semantics match the X3 rules they replace:
+//
+//    stmt_eol = (comment >> *(char_ - eol) >> -eol) | separator | eol
+//
+// In particular, leading blanks are consumed even if match fails (as
+// is done by the X3 skipper for literal & `eol` parsers)
+
+#include <boost/spirit/home/x3.hpp>
+
+namespace kas::parser
+{
+namespace x3 = boost::spirit::x3;
+
+namespace detail
+{
+    // match prefix `s` (NB: empty string never matches)
+    template <typename Iter>
+    bool scan_lit(Iter& first, Iter const& last, const char *s)
+    {
+        if (!s || !*s)
+            return false;
+
+        auto it = first;
+        for (; *s; ++s, ++it)
+            if (it == last || *it != *s)
+                return false;
+        first = it;
+        return true;
+    }
+
+    // x3::eol: match "\r\n", "\r", or "\n"
+    template <typename Iter>
+    bool scan_eol(Iter& first, Iter const& last)
+    {
+        if (first == last)
+            return false;
+        if (*first == '\n')
+        {
+            ++first;
+            return true;
+        }
+        if (*first != '\r')
+            return false;
+        if (++first != last && *first == '\n')
+            ++first;
+        return true;
+    }
+
+    template <typename Iter>
+    void scan_blanks(Iter& first, Iter const& last)
+    {
+        while (first != last && (*first == ' ' || *first == '\t'))
+            ++first;
+    }
+
+    template <typename Iter>
+    bool scan_stmt_end(Iter& first, Iter const& last
+                     , const char *comment, const char *separator)
+    {
+        scan_blanks(first, last);
+        if (scan_lit(first, last, comment))
+        {
+            while (first != last && *first != '\n' && *first != '\r')
+                ++first;
+            scan_eol(first, last);
+            return true;
+        }
+        return scan_lit(first, last, separator) || scan_eol(first, last);
+    }
+}
+
+// match end of statement: comment, separator, or end-of-line
+template <typename COMMENT, typename SEPARATOR>
+struct scan_eol_parser : x3::parser<scan_eol_parser<COMMENT, SEPARATOR>>
+{
+    using attribute_type = x3::unused_type;
+    static bool const has_attribute = false;
+
+    template <typename Iter, typename Context, typename RContext, typename Attribute>
+    bool parse(Iter& first, Iter const& last
+             , Context const&, RContext&, Attribute&) const
+    {
+        return detail::scan_stmt_end(first, last, COMMENT{}(), SEPARATOR{}());
+    }
+};
+
+// absorb empty statements: always matches
+template <typename COMMENT, typename SEPARATOR>
+struct scan_blank_parser : x3::parser<scan_blank_parser<COMMENT, SEPARATOR>>
+{
+    using attribute_type = x3::unused_type;
+    static bool const has_attribute = false;
+
+    template <typename Iter, typename Context, typename RContext, typename Attribute>
+    bool parse(Iter& first, Iter const& last
+             , Context const&, RContext&, Attribute&) const
+    {
+        while (detail::scan_stmt_end(first, last, COMMENT{}(), SEPARATOR{}()))
+            ;
+        return true;
+    }
+};
+
+template <typename COMMENT, typename SEPARATOR>
+constexpr auto scan_eol   = scan_eol_parser  <COMMENT, SEPARATOR>{};
+
+template <typename COMMENT, typename SEPARATOR>
+constexpr auto scan_blank = scan_blank_parser<COMMENT, SEPARATOR>{};
+
+}
+
+#endif
@@ -23,14 +23,35 @@ using Iter = kas::parser::iterator_type;
 
 struct parser_src
 {
+    // describe text containing object (for diagnostics)
+    struct src_text
+    {
+        Iter first;
+        Iter last;
+        std::string fname;
+        std::shared_ptr<x3_line_index> lines;
+    };
+
     // describe object (eg file) to be parsed
     struct src_obj
     {
-        src_obj(src_obj *prev, Iter const& first, Iter const& last, std::string&& fname)
-            : prev(prev)
+        src_obj(src_obj *prev, Iter const& first, Iter const& last, std::string&& fname
+              , std::shared_ptr<x3_line_index> lines = {})
+            : src_obj(prev, first, last, {first, last, std::move(fname), std::move(lines)})
+            {
+                expansion = false;
+            }
+
+        // parse [first, last) span of `text` `repeat` times (eg: macro body)
+        // NB: diagnostics report locations in `text`
+        src_obj(src_obj *prev, Iter const& first, Iter const& last
+              , src_text const& text, unsigned repeat = 1)
+            : first(first)
             , iter(first)
             , last(last)
-            , e_handler(error_handler<Iter>(first, last, std::move(fname)))
+            , repeat(repeat)
+            , e_handler(error_handler<Iter>(text.first, text.last, std::string(text.fname), text.lines))
+            , prev(prev)
             {
             }
 
@@ -39,8 +60,11 @@ struct parser_src
             return e_handler.raw_where(loc);
         }
         
+        Iter first;
         Iter iter;
         Iter last;
+        unsigned repeat;
+        bool expansion {true};      // not file (eg: macro body)
         error_handler_type e_handler;
         src_obj *prev;
     };
@@ -72,12 +96,50 @@ public:
         delete &obj;
     }
     
+    // number of nested objects (eg: for `.include` limit)
+    static unsigned depth()
+    {
+        unsigned n {};
+        for (auto p = current; p; p = p->prev)
+            ++n;
+        return n;
+    }
+
+    // at end of object: restart if repeat count remains
+    static bool restart()
+    {
+        if (current->repeat <= 1)
+            return false;
+        --current->repeat;
+        current->iter = current->first;
+        return true;
+    }
+
+    // end current expansion at `end`, including repeats (eg: `.exitm`)
+    // return false if current object is file
+    static bool exit(Iter const& end)
+    {
+        if (!current || !current->expansion)
+            return false;
+        current->repeat = 1;
+        current->last   = end;
+        return true;
+    }
+
+    // text of current object (eg: to push span of macro body)
+    static src_text text()
+    {
+        auto& h = current->e_handler;
+        return { h.first(), h.last(), h.fname(), h.line_index() };
+    }
+
     // allow iteration over current object
-    operator bool() const { return current;       }
-    auto& iter()          { return current->iter; }
-    auto& last() const    { return current->last; }
+    // NB: static to allow directives to consume text (eg: `.rept` body)
+    operator bool() const        { return current;       }
+    static auto& iter()          { return current->iter; }
+    static auto& last()          { return current->last; }
 
-    auto& e_handler() const { return current->e_handler; }
+    static auto& e_handler()     { return current->e_handler; }
 
     // trace begin/end of src_obj 
     static void set_trace(std::ostream *out)
@@ -20,6 +20,11 @@
 // added to `tgt_insn` list. If no `mcodes` pass, the first failed test 
 // condition is stored in `tgt_insn::tst` for error message generation.
 //
+// NB: the insn tables are built on first use, after options are parsed, so
+// hardware tests are evaluated once per `mcode` & not when insns are
+// evaluated. The `mcodes()` list (& thus the `ok_bitset_t` indexes) holds
+// only mcodes supported by the selected configuration.
+//
 // NB: The `tgt_insn` type is the only target base type which does not use the CRTP
 // pattern. The "name" -> "mcode" pattern is always the same, so no customization 
 // is required for various processors
@@ -95,10 +100,13 @@ struct tgt_insn_t
     void add_mcode(mcode_t *);
 
     // retrieve error message if no mcodes
-    auto err() const
+    // NB: `tst` is first hardware test failed when mcodes added
+    const char *err() const
     {
-        return "ERR no mcodes";
-        return (*hw_cpu_p)[tst];
+        if (tst)
+            if (auto msg = (*hw_cpu_p)[tst])
+                return msg;
+        return "X instruction not supported";
     }
 
     // stmt interface: NB: defer naming types
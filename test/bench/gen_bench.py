@@ -0,0 +1,138 @@
+#!/usr/bin/python3
+
+# generate synthetic large assembler sources for benchmarking
+#
+# eg: ./gen_bench.py m68k branch 20000 > branch.s
+#
+# Each corpus stresses a different part of the assembler:
+#
+#   branch  : dense short & long conditional branches (stresses relax)
+#   table   : label-difference data tables (stresses expressions & relax)
+#   dwarf   : `.loc` on every insn with `.cfi_*` frames (stresses DWARF)
+#   symbol  : many global, local, equated & common symbols
+#
+# Output is deterministic for a given (target, corpus, size).
+
+import random
+import sys
+
+# per-target instruction templates
+# `insns` are straight-line instructions, `branches` take a label
+# `word` is a data directive for an address sized value
+TARGETS = {
+    'm68k': {
+        'insns'    : [ 'move.l %d0,%d1', 'addq.l #1,%d0', 'move.w (%a0)+,%d2'
+                     , 'lea 4(%a1),%a1', 'cmp.l %d1,%d0', 'clr.l %d3'
+                     , 'moveq #12,%d4', 'add.l %d4,%d5' ],
+        'branches' : [ 'bra', 'beq', 'bne', 'bge', 'blt', 'bsr' ],
+        'call'     : 'jsr',
+        'word'     : '.long',
+    },
+    'arm': {
+        'insns'    : [ 'mov r0, r1', 'add r0, r0, #1', 'ldr r2, [r3]'
+                     , 'str r2, [r3, #4]', 'cmp r0, r1', 'sub r4, r4, r5'
+                     , 'mov r6, #12', 'orr r7, r7, r8' ],
+        'branches' : [ 'b', 'beq', 'bne', 'bge', 'blt', 'bl' ],
+        'call'     : 'bl',
+        'word'     : '.long',
+    },
+    'z80': {
+        'insns'    : [ 'ld a, b', 'inc hl', 'ld (hl), a', 'add a, c'
+                     , 'dec de', 'ld bc, 1234', 'or a', 'ex de, hl' ],
+        'branches' : [ 'jr', 'jr nz,', 'jr z,', 'jp', 'jp nc,', 'djnz' ],
+        'call'     : 'call',
+        'word'     : '.2byte',
+    },
+}
+
+def branch(t, rnd, n):
+    # blocks of straight-line code with branches to nearby & distant labels
+    # most branches are short, some cross large distances
+    out = [ '\t.text' ]
+    for i in range(n):
+        out.append('L{}:'.format(i))
+        for _ in range(rnd.randint(1, 4)):
+            out.append('\t' + rnd.choice(t['insns']))
+        if rnd.random() < 0.9:
+            dest = min(n - 1, max(0, i + rnd.randint(-8, 8)))
+        else:
+            dest = rnd.randrange(n)
+        op = rnd.choice(t['branches'])
+        sep = ' ' if op.endswith(',') else '\t'
+        out.append('\t{}{}L{}'.format(op, sep, dest))
+    return out
+
+def table(t, rnd, n):
+    # code with labels, followed by tables of label differences
+    out = [ '\t.text' ]
+    for i in range(n):
+        out.append('T{}:'.format(i))
+        for _ in range(rnd.randint(1, 3)):
+            out.append('\t' + rnd.choice(t['insns']))
+    out.append('\t.data')
+    out.append('jump_table:')
+    for i in range(n - 1):
+        out.append('\t{} T{}-T0'.format(t['word'], i + 1))
+        out.append('\t{} T{}-T{}'.format(t['word'], i + 1, i))
+    return out
+
+def dwarf(t, rnd, n):
+    # functions with `.loc` before every insn & CFI frames
+    out = [ '\t.file\t"bench.c"', '\t.text', '\t.file 1 "bench.c"' ]
+    line = 1
+    for f in range(n):
+        out.append('\t.globl\tfn{}'.format(f))
+        out.append('fn{}:'.format(f))
+        out.append('\t.cfi_startproc')
+        for k in range(rnd.randint(2, 8)):
+            line += rnd.choice([0, 1, 1, 1, 2, 3, 7, -4])
+            line  = max(line, 1)
+            out.append('\t.loc 1 {} {}'.format(line, rnd.randint(0, 12)))
+            out.append('\t' + rnd.choice(t['insns']))
+            if k == 0:
+                out.append('\t.cfi_def_cfa_offset {}'.format(8 + 4 * rnd.randint(0, 4)))
+        out.append('\t.cfi_endproc')
+    return out
+
+def symbol(t, rnd, n):
+    # many symbols: equates, globals, locals, commons & references
+    out = [ '\t.text' ]
+    for i in range(n):
+        kind = i % 4
+        if kind == 0:
+            out.append('equ_{} = {}'.format(i, rnd.randint(0, 1 << 15)))
+        elif kind == 1:
+            out.append('\t.globl\tglob_{}'.format(i))
+            out.append('glob_{}:'.format(i))
+            out.append('\t' + rnd.choice(t['insns']))
+        elif kind == 2:
+            out.append('\t.comm\tcomm_{},{}'.format(i, 4 * rnd.randint(1, 16)))
+        else:
+            out.append('.Llocal_{}:'.format(i))
+            out.append('\t{}\tglob_{}'.format(t['call'], rnd.randrange(1, n, 4)))
+    return out
+
+CORPORA = {
+    'branch' : branch,
+    'table'  : table,
+    'dwarf'  : dwarf,
+    'symbol' : symbol,
+}
+
+def generate(target, corpus, size):
+    rnd = random.Random('{}-{}-{}'.format(target, corpus, size))
+    return '\n'.join(CORPORA[corpus](TARGETS[target], rnd, size)) + '\n'
+
+if __name__ == '__main__':
+    import argparse
+
+    parser = argparse.ArgumentParser(
+        description="Generate synthetic assembler source for benchmarks")
+
+    parser.add_argument('target', choices=sorted(TARGETS))
+    parser.add_argument('corpus', choices=sorted(CORPORA))
+    parser.add_argument('size', type=int, nargs='?', default=20000,
+                        help="number of blocks to generate")
+    args = parser.parse_args()
+
+    sys.stdout.write(generate(args.target, args.corpus, args.size))
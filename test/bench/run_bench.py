@@ -0,0 +1,236 @@
+#!/usr/bin/python3
+
+# benchmark driver: assemble synthetic corpora & report performance
+#
+# eg: ./run_bench.py --as ./as --target m68k
+#     ./run_bench.py --target arm=./as-arm --target m68k=./as-m68k
+#
+# kas is built for a single target, so each target to be benchmarked is
+# given as `TARGET=ASSEMBLER` (`--as` is used if no assembler given).
+# The default is the configured target. `make bench-all` builds & runs
+# each target in `BENCH_TARGETS`.
+#
+# For each target & corpus from `gen_bench.py`, run the assembler with
+# `--statistics` and report:
+#
+#   - throughput: source lines/s and instructions/s
+#   - per-phase wall time (from `core_stats` output)
+#   - peak RSS of the assembler process
+#
+# Results are compared against a stored baseline (if present) in
+# `baseline/<target>.json`. Use `--save-baseline` to record a new baseline.
+# Exit status is non-zero if any metric regresses more than `--threshold`.
+#
+# `--relax-compare` instead runs each corpus with each `--relax` strategy
+# and reports relax passes & time side by side.
+
+import json
+import os
+import subprocess
+import sys
+import tempfile
+import time
+from pathlib import Path
+
+import gen_bench
+
+BENCH_DIR = Path(__file__).resolve().parent
+
+# parse `core_stats::print` output
+# relax rows are: segment, passes, grow, wall, fuzz...
+def parse_stats(text):
+    phases, counters = {}, {}
+    relax = { 'passes': 0, 'grow': 0, 'segments': 0 }
+    section = None
+    for line in text.splitlines():
+        fields = line.split()
+        if not fields:
+            section = None
+            continue
+        # table header follows blank line
+        if not section and fields[0] in ('phase', 'counter', 'relax', 'obstack'):
+            section = fields[0]
+            continue
+        try:
+            if section == 'phase':
+                phases[fields[0]] = float(fields[1])
+            elif section == 'counter':
+                counters[' '.join(fields[:-1])] = int(fields[-1])
+            elif section == 'relax':
+                passes, grow = fields[1:3]
+                relax['passes']   += int(passes)
+                relax['grow']     += int(grow)
+                relax['segments'] += 1
+        except (ValueError, IndexError):
+            pass
+    return phases, counters, relax
+
+# run assembler in child process: return (output, wall, peak rss bytes)
+def run_as(assembler, src, obj, extra = []):
+    start = time.monotonic()
+    proc  = subprocess.Popen([assembler, '--statistics', *extra, '-o', obj, src],
+                             stdout=subprocess.PIPE, stderr=subprocess.STDOUT,
+                             universal_newlines=True)
+    output = proc.stdout.read()
+    _, status, rusage = os.wait4(proc.pid, 0)
+    wall = time.monotonic() - start
+    proc.returncode = os.waitstatus_to_exitcode(status)
+
+    # `ru_maxrss` is KB on linux, bytes on macOS
+    rss = rusage.ru_maxrss
+    if sys.platform != 'darwin':
+        rss *= 1024
+    return proc.returncode, output, wall, rss
+
+def bench_one(args, target, corpus, work):
+    src  = work / '{}-{}.s'.format(target, corpus)
+    obj  = work / '{}-{}.o'.format(target, corpus)
+    text = gen_bench.generate(target, corpus, args.size)
+    src.write_text(text)
+    lines = text.count('\n')
+
+    best = None
+    for _ in range(args.repeat):
+        rc, output, wall, rss = run_as(args.targets[target], str(src), str(obj), args.as_arg)
+        if rc:
+            print('{}: assembler failed (status {})'.format(corpus, rc))
+            return None
+        if not best or wall < best['wall']:
+            phases, counters, relax = parse_stats(output)
+            insns = counters.get('instructions', 0)
+            best = {
+                'lines'     : lines,
+                'insns'     : insns,
+                'wall'      : wall,
+                'lines_per_s': lines / wall,
+                'insns_per_s': insns / wall,
+                'peak_rss'  : rss,
+                'phases'    : phases,
+                'relax'     : relax,
+            }
+    return best
+
+# metrics where larger is worse
+COSTS = ('wall', 'peak_rss')
+RATES = ('lines_per_s', 'insns_per_s')
+
+def compare(name, result, base, threshold):
+    regressed = False
+    for key in COSTS + RATES:
+        if key not in base or not base[key]:
+            continue
+        delta = (result[key] - base[key]) / base[key] * 100
+        worse = delta > threshold if key in COSTS else -delta > threshold
+        flag  = '  REGRESSION' if worse else ''
+        print('    {:12} {:+7.1f}% vs baseline{}'.format(key, delta, flag))
+        regressed |= worse
+    return regressed
+
+def report(name, r):
+    print('{}: {} lines, {} insns'.format(name, r['lines'], r['insns']))
+    print('    wall {:.3f}s  {:.0f} lines/s  {:.0f} insns/s  peak rss {:.1f} MB'.format(
+        r['wall'], r['lines_per_s'], r['insns_per_s'], r['peak_rss'] / (1 << 20)))
+    for phase, t in r['phases'].items():
+        print('    {:20} {:.6f}s'.format(phase, t))
+
+RELAX_STRATEGIES = ('fuzz', 'grow')
+
+def relax_compare(args, target, corpus, work):
+    print('{}:'.format(corpus))
+    print('    {:8} {:>8} {:>8} {:>12} {:>10}'.format(
+        'relax', 'passes', 'grow', 'relax(s)', 'wall(s)'))
+    as_arg = args.as_arg
+    for strategy in RELAX_STRATEGIES:
+        args.as_arg = as_arg + ['--relax={}'.format(strategy)]
+        r = bench_one(args, target, corpus, work)
+        if not r:
+            return False
+        print('    {:8} {:8} {:8} {:12.6f} {:10.3f}'.format(strategy,
+            r['relax']['passes'], r['relax']['grow'],
+            r['phases'].get('relax', 0), r['wall']))
+    args.as_arg = as_arg
+    return True
+
+def configured_target():
+    try:
+        return (BENCH_DIR / '../../config.status').read_text().strip()
+    except OSError:
+        return None
+
+# benchmark target: `TARGET` or `TARGET=ASSEMBLER`
+def target_arg(arg):
+    target, _, assembler = arg.partition('=')
+    if target not in gen_bench.TARGETS:
+        raise argparse.ArgumentTypeError('unknown target: {}'.format(target))
+    return target, assembler or None
+
+# run all corpora for `target`: return True if regressed (or failed)
+def bench_target(args, target):
+    baseline_path = BENCH_DIR / 'baseline' / '{}.json'.format(target)
+    baseline = {}
+    if baseline_path.is_file():
+        baseline = json.loads(baseline_path.read_text())
+    elif not args.save_baseline and not args.relax_compare:
+        print('no baseline for {}: run `make bench-baseline` & commit {}'.format(
+            target, baseline_path.relative_to(BENCH_DIR.parent.parent)))
+
+    print('target {} ({})'.format(target, args.targets[target]))
+    results, regressed = {}, False
+    with tempfile.TemporaryDirectory(prefix='kas_bench') as work:
+        for corpus in args.corpus or sorted(gen_bench.CORPORA):
+            if args.relax_compare:
+                regressed |= not relax_compare(args, target, corpus, Path(work))
+                continue
+            r = bench_one(args, target, corpus, Path(work))
+            if not r:
+                regressed = True
+                continue
+            results[corpus] = r
+            report(corpus, r)
+            base = baseline.get(corpus)
+            if base and base.get('size') == args.size:
+                regressed |= compare(corpus, r, base, args.threshold)
+            r['size'] = args.size
+
+    if args.save_baseline and not args.relax_compare:
+        baseline_path.parent.mkdir(exist_ok=True)
+        baseline_path.write_text(json.dumps(results, indent=2, sort_keys=True) + '\n')
+        print('baseline saved: {}'.format(baseline_path))
+    return regressed
+
+if __name__ == '__main__':
+    import argparse
+
+    parser = argparse.ArgumentParser(description="kas benchmark driver")
+    parser.add_argument('--as', dest='assembler', default='./as',
+                        help="assembler for targets given without one")
+    parser.add_argument('--as-arg', action='append', default=[],
+                        help="additional assembler argument (repeatable)")
+    parser.add_argument('--target', dest='target_args', action='append',
+                        type=target_arg, metavar='TARGET[=ASSEMBLER]',
+                        help="target to run (repeatable, default: configured)")
+    parser.add_argument('--corpus', action='append',
+                        choices=sorted(gen_bench.CORPORA),
+                        help="corpus to run (default: all)")
+    parser.add_argument('--size', type=int, default=20000)
+    parser.add_argument('--repeat', type=int, default=3,
+                        help="runs per corpus (best time reported)")
+    parser.add_argument('--threshold', type=float, default=10.0,
+                        help="regression threshold in percent")
+    parser.add_argument('--save-baseline', action='store_true')
+    parser.add_argument('--relax-compare', action='store_true',
+                        help="compare `--relax` strategies (no baseline)")
+    args = parser.parse_args()
+
+    if not args.target_args:
+        if not configured_target():
+            parser.error('kas is unconfigured: specify --target')
+        args.target_args = [(configured_target(), None)]
+
+    args.targets = { t: a or args.assembler for t, a in args.target_args }
+
+    regressed = False
+    for target in args.targets:
+        regressed |= bench_target(args, target)
+
+    sys.exit(1 if regressed else 0)
@@ -9,14 +9,50 @@
 // Hardcode Z80 Opcodes : 0x18 is JR, 0xc3 is JMP
 // Conditional base code: 0x20 is JR_CC, and 0xc3 is JMP_CC
 // For conditional instructions, the condition is shifted 3 bits for both
+//
+// With `--optimize-speed`, select JMP when it is faster than an in-range JR.
+// JR is 12 T-states (7 if condition false) & JMP is always 10. Thus JMP is
+// used for unconditional branches & conditional branches assumed taken. A
+// conditional branch is assumed taken if it is backward (ie loop backedge).
 
 
+#include "z80_options.h"
 #include "target/tgt_opc_branch.h"
 
 namespace kas::z80::opc
 {
 struct z80_opc_branch : tgt::opc::tgt_opc_branch<z80_mcode_t>
 {
+    fits_result do_size(mcode_t const& mcode
+                      , argv_t& args
+                      , decltype(data_t::size)& size
+                      , expr_fits const& fits
+                      , stmt_info_t info) const override
+    {
+        auto result = tgt_opc_branch::do_size(mcode, args, size, fits, info);
+        if (!z80_options::optimize_speed)
+            return result;
+
+        // ** dest is final arg. conditional if two args **
+        auto arg_c = mcode.vals().size();
+        auto& arg  = args[arg_c-1];
+        
+        // only in-range JR can be converted
+        if (arg.mode() != MODE_BRANCH_BYTE)
+            return result;
+
+        // conditional: use JR unless backward
+        // NB: `max` of zero tests for deletion. Test `offset <= 0` as `< 1`
+        if (arg_c > 1)
+            if (fits.disp(arg.expr, -(1 << 16), 1, 0) != fits.yes)
+                return result;
+
+        // convert JR -> JMP: opcode + address
+        arg.set_mode(MODE_BRANCH_WORD);
+        size = mcode.base_size() + 2;
+        return fits.yes;
+    }
+
     void do_emit(core::core_emit& base
                        , mcode_t const& mcode
                        , argv_t& args
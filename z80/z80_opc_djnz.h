@@ -9,7 +9,14 @@
 //
 //  djnz +2; jr +3; jmp dest; ...;
 // 
-// the sequence is 7 bytes
+// the sequence is 7 bytes & preserves flags
+//
+// With `--optimize-speed`, emit out-of-range `djnz` as
+//
+//  dec b; jmp nz, dest
+//
+// the sequence is 4 bytes & 14 T-states (vs 23 taken for the above),
+// but modifies flags. In-range `djnz` is always fastest (13/8 T-states).
 
 #include "z80_opc_branch.h"
 
@@ -25,14 +32,34 @@ struct z80_opc_djnz : tgt::opc::tgt_opc_branch<z80_mcode_t>
     using NAME = KAS_STRING("Z80_DJNZ");
     const char *name() const override { return NAME::value; }
 
-    // XXX report sequence size as `max`
+    // hand assemble: "djnz +2; jr +3; jmp"
+    // NB: DJNZ opcode is first byte
+    static constexpr uint8_t long_djnz[] = { 0x10, 0x02, 0x18, 0x03, 0xc3 };
+
+    // hand assemble: "dec b; jmp nz"
+    static constexpr uint8_t fast_djnz[] = { 0x05, 0xc2 };
+
+    // size of out-of-range sequence: opcodes + address
+    static uint8_t long_size()
+    {
+        if (z80_options::optimize_speed)
+            return sizeof(fast_djnz) + 2;
+        return sizeof(long_djnz) + 2;
+    }
+
+    // validator sizes `djnz` + displacement: adjust for sequence
     fits_result do_size(mcode_t const& mcode
                       , argv_t& args
                       , decltype(data_t::size)& size
                       , expr_fits const& fits
                       , stmt_info_t info) const override
     {
-        return tgt_opc_branch::do_size(mcode, args, size, fits, info);
+        auto result = tgt_opc_branch::do_size(mcode, args, size, fits, info);
+        if (args[0].mode() == MODE_BRANCH_WORD)
+            size = long_size();
+        else if (result != fits.yes)
+            size.max = long_size();
+        return result;
     }
 
     void do_emit(core::core_emit& base
@@ -40,10 +67,6 @@ struct z80_opc_djnz : tgt::opc::tgt_opc_branch<z80_mcode_t>
                        , argv_t& args
                        , stmt_info_t info) const override
     {
-        // hand assemble: "djnz +2; jr +3; jmp"
-        // NB: DJNZ opcode is first byte
-        static constexpr uint8_t long_djnz[] = { 0x10, 0x02, 0x18, 0x03, 0xc3 };
-        
         // test "mode" of dest (BYTE or WORD)
         auto branch_mode =  args[0].mode();
 
@@ -56,8 +79,12 @@ struct z80_opc_djnz : tgt::opc::tgt_opc_branch<z80_mcode_t>
                 break;
             case MODE_BRANCH_WORD:
                 // convert DJNZ to sequence of insns and use JMP to exit
-                for (auto c : long_djnz)
-                    base << c;
+                if (z80_options::optimize_speed)
+                    for (auto c : fast_djnz)
+                        base << c;
+                else
+                    for (auto c : long_djnz)
+                        base << c;
                 base << core::set_size(2) << args[0].expr;
                 break;
             default:
@@ -23,12 +23,29 @@ struct set_hw_defn
 
     int target;    
 };
+
+// options read outside the options translation unit
+// NB: static members (not unnamed struct) so all translation units share
+struct z80_options
+{
+    static inline bool optimize_speed;
+};
+
+struct add_z80_options
+{
+    void operator()(options::po_defns& defns) const
+    {
+        defns.add("Z80 Options")
+            ("--optimize-speed"       , "select fastest (not smallest) branch forms"
+                                                                , z80_options::optimize_speed)
+            ;
+    }
+};
 }
 
 namespace kas::expression::detail
 {
-    // EXAMPLE
-    //template <> struct options_types_v<defn_cpu> : meta::id<z80::add_z80_options> {};
+    template <> struct options_types_v<defn_cpu> : meta::id<z80::add_z80_options> {};
 }
 
 
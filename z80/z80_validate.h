@@ -481,7 +481,7 @@ VAL_GEN(INDIR_IDX   , val_indir_idx);
 VAL_GEN(JR_CC       , val_jrcc);
 
 // For branches only: config_sizes areare size of insn, not arg
-VAL_GEN (BRANCH    ,  val_branch, 2, 2);    // branch byte in range (DJNZ)
+VAL_GEN (BRANCH    ,  val_branch, 1, 2);    // branch byte or word (DJNZ)
 VAL_GEN (BRANCH_DEL,  val_branch, 0);       // branch byte/word/long DELETE-ABLE
 
 // Validate numeric arguments